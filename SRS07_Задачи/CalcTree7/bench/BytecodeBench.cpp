@@ -0,0 +1,91 @@
+/**
+ * @file BytecodeBench.cpp
+ * @brief Сравнение обхода дерева, интерпретатора байт-кода и JIT при многократном вычислении
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/BytecodeBench.cpp \
+ *       perplexity/BytecodeProgram.cpp perplexity/JitExpression.cpp \
+ *       perplexity/ExpressionTree.cpp perplexity/TreeEmitter.cpp perplexity/WorkStealingScheduler.cpp \
+ *       -o bytecode_bench
+ * Запуск: ./bytecode_bench expression-file [repeats] [--no-fold]
+ *
+ * Дерево сворачивается (если не задан --no-fold), компилируется в байт-код и
+ * вычисляется каждым способом (короткие — многократно в цикле). Печатаются размеры программы и машинного
+ * кода, лучшее время одного вычисления и ускорение; при расхождении результатов — ошибка.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "BytecodeProgram.h"
+#include "JitExpression.h"
+#include "ExpressionTree.h"
+
+using namespace std;
+
+/**
+ * @brief Лучшее среднее время вызова функции из repeats попыток по iterations вызовов
+ */
+template <typename Function>
+double BestTime(int repeats, size_t iterations, Function&& function, long long& value) {
+    double best = 1e100;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) value = function();
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - t0).count() / iterations);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " expression-file [repeats] [--no-fold]" << endl;
+        return 1;
+    }
+    int repeats = argc > 2 ? atoi(argv[2]) : 20;
+    bool fold = !(argc > 3 && strcmp(argv[3], "--no-fold") == 0);
+
+    ExpressionTree tree(argv[1]);
+    if (fold) tree.TransformTree();
+
+    auto t0 = chrono::steady_clock::now();
+    BytecodeProgram program(tree);
+    double compile = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    BytecodeVM vm(program);
+    JitExpression jit(program);
+
+    cout << "Инструкций: " << program.Code().size() - 1 << ", регистров: " << program.RegisterCount()
+         << " (констант " << program.ConstantCount() << "), компиляция " << compile * 1000 << " мс\n";
+
+    // Короткие выражения вычисляются много раз подряд, чтобы замер был точным
+    size_t iterations = max<size_t>(1, 10000000 / program.Code().size());
+    long long tree_value = 0;
+    long long vm_value = 0;
+    double tree_time = BestTime(repeats, iterations, [&] { return tree.Evaluate(); }, tree_value);
+    double vm_time = BestTime(repeats, iterations, [&] { return vm.Run(); }, vm_value);
+
+    if (tree_value != vm_value) {
+        cerr << "Результаты различаются: " << tree_value << " и " << vm_value << endl;
+        return 1;
+    }
+    cout << "Значение: " << vm_value << '\n';
+    cout << "Обход дерева: " << tree_time * 1e6 << " мкс, байт-код: " << vm_time * 1e6
+         << " мкс, ускорение " << tree_time / vm_time << "x\n";
+
+    if (!jit.IsNative()) {
+        cout << "JIT недоступен, используется интерпретатор\n";
+        return 0;
+    }
+    long long jit_value = 0;
+    double jit_time = BestTime(repeats, iterations, [&] { return jit.Evaluate(); }, jit_value);
+    if (jit_value != vm_value) {
+        cerr << "JIT дает другой результат: " << jit_value << endl;
+        return 1;
+    }
+    cout << "JIT: " << jit_time * 1e6 << " мкс (" << jit.CodeSize() << " байт кода), ускорение "
+         << tree_time / jit_time << "x\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ColumnarBench.cpp
+ * @brief Замер пропускной способности столбцового вычисления шаблона выражения
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O3 -march=native -pthread -Iperplexity bench/ColumnarBench.cpp \
+ *       perplexity/ColumnarEvaluator.cpp perplexity/ExpressionTree.cpp \
+ *       perplexity/TreeEmitter.cpp perplexity/WorkStealingScheduler.cpp -o columnar_bench
+ * Запуск: ./columnar_bench template-file [rows] [repeats]
+ *
+ * Шаблон — выражение в префиксной форме с переменными x0, x1, ...; столбцы
+ * заполняются случайными значениями 1..100. Печатается время пакета, число строк
+ * и применений операций в секунду и доля строк с делением на ноль.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ColumnarEvaluator.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " template-file [rows] [repeats]" << endl;
+        return 1;
+    }
+    size_t rows = argc > 2 ? strtoull(argv[2], nullptr, 10) : (size_t{1} << 22);
+    int repeats = argc > 3 ? atoi(argv[3]) : 10;
+
+    ColumnarExpression expression = ColumnarExpression::FromFile(argv[1]);
+    cout << "Операций: " << expression.OperationCount() << ", переменных: "
+         << expression.VariableCount() << ", строк: " << rows << '\n';
+
+    mt19937_64 rng(7);
+    vector<vector<long long>> columns(expression.VariableCount(), vector<long long>(rows));
+    ColumnBatch batch;
+    batch.rows = rows;
+    for (auto& column : columns) {
+        for (auto& value : column) value = static_cast<long long>(rng() % 100) + 1;
+        batch.columns.push_back(column.data());
+    }
+
+    vector<long long> out(rows);
+    vector<uint8_t> valid(rows);
+    double best = 1e100;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        expression.Evaluate(batch, out.data(), valid.data());
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - t0).count());
+    }
+
+    size_t invalid = 0;
+    for (uint8_t v : valid) invalid += !v;
+    cout << "Лучшее время: " << best * 1000 << " мс, " << rows / best / 1e6 << " млн строк/с, "
+         << expression.OperationCount() * rows / best / 1e9 << " млрд операций/с\n";
+    cout << "Строк с делением на ноль: " << invalid << '\n';
+    return 0;
+}
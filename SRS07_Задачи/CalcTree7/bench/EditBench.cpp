@@ -0,0 +1,82 @@
+/**
+ * @file EditBench.cpp
+ * @brief Пересчет после правки листа в сравнении с полной перестройкой дерева
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/EditBench.cpp perplexity/EditableExpressionTree.cpp \
+ *       perplexity/ExpressionTree.cpp perplexity/TreeEmitter.cpp perplexity/WorkStealingScheduler.cpp -o edit_bench
+ * Запуск: ./edit_bench expression-file [edits]
+ *
+ * Случайным листам присваиваются значения 1-9 (ненулевые, чтобы не получить
+ * деление на ноль). Печатается среднее время правки и число пересчитанных
+ * операций, а также время одной перестройки и свертки ExpressionTree; после
+ * правок значение сравнивается с перестроенным деревом.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "EditableExpressionTree.h"
+#include "ExpressionTree.h"
+
+using namespace std;
+
+/**
+ * @brief Время выполнения функции в миллисекундах
+ */
+template <typename Function>
+double Milliseconds(Function&& function) {
+    auto t0 = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " expression-file [edits]" << endl;
+        return 1;
+    }
+    size_t edits = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+    vector<long long> tokens = ExpressionTree::ReadExpression(argv[1]);
+    EditableExpressionTree editable(tokens);
+    vector<size_t> leaves;
+    for (size_t i = 0; i < editable.Size(); ++i) {
+        if (editable.IsLeaf(i)) leaves.push_back(i);
+    }
+    if (leaves.empty()) {
+        cerr << "Пустое выражение" << endl;
+        return 1;
+    }
+
+    mt19937_64 random(1);
+    size_t recomputed = 0;
+    double edit = Milliseconds([&] {
+        for (size_t k = 0; k < edits; ++k) {
+            size_t i = leaves[random() % leaves.size()];
+            long long value = 1 + static_cast<long long>(random() % 9);
+            tokens[i] = value;
+            recomputed += editable.SetLeaf(i, value);
+        }
+    });
+
+    long long expected = 0;
+    double rebuild = Milliseconds([&] {
+        ExpressionTree tree(tokens);
+        expected = tree.Evaluate();
+        tree.TransformTree();
+    });
+    if (expected != editable.Value()) {
+        cerr << "Значение " << editable.Value() << " не совпало с перестроенным " << expected << endl;
+        return 1;
+    }
+
+    cout << "Узлов: " << editable.Size() << ", правок: " << edits << '\n';
+    cout << "правка: " << edit * 1e3 / edits << " мкс, в среднем " << static_cast<double>(recomputed) / edits
+         << " пересчитанных операций\n";
+    cout << "перестройка и свертка: " << rebuild << " мс\n";
+    return 0;
+}
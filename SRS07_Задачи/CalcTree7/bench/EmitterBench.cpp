@@ -0,0 +1,86 @@
+/**
+ * @file EmitterBench.cpp
+ * @brief Замер скорости вывода дерева в префиксной, инфиксной и постфиксной формах
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/EmitterBench.cpp perplexity/TreeEmitter.cpp \
+ *       perplexity/ExpressionTree.cpp perplexity/WorkStealingScheduler.cpp -o emitter_bench
+ * Запуск: ./emitter_bench expression-file [output-file]
+ *
+ * Для каждой формы печатается время подсчета длины, записи в заранее выделенный
+ * буфер и вывода в файл (по умолчанию /dev/null) через буфер TreeEmitter.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ExpressionTree.h"
+#include "TreeEmitter.h"
+
+using namespace std;
+
+/**
+ * @brief Время выполнения функции в миллисекундах
+ */
+template <typename Function>
+double Milliseconds(Function&& function) {
+    auto t0 = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " expression-file [output-file]" << endl;
+        return 1;
+    }
+    const char* output = argc > 2 ? argv[2] : "/dev/null";
+    int fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        cerr << "Не удалось открыть файл: " << output << endl;
+        return 1;
+    }
+
+    ExpressionTree tree(argv[1]);
+    const TreeNode* root = tree.Root();
+    // В префиксной форме после каждого токена ровно один пробел
+    size_t tokens = 0;
+    {
+        string text;
+        tree.AppendPrefix(text);
+        for (char c : text) tokens += c == ' ';
+    }
+    cout << "Токенов: " << tokens << '\n';
+
+    const pair<TreeEmitter::Notation, const char*> notations[] = {
+        {TreeEmitter::PREFIX, "префиксная"},
+        {TreeEmitter::INFIX, "инфиксная"},
+        {TreeEmitter::POSTFIX, "постфиксная"},
+    };
+
+    TreeEmitter emitter;
+    vector<char> buffer;
+    for (const auto& [notation, name] : notations) {
+        size_t length = 0;
+        double measure = Milliseconds([&] { length = TreeEmitter::Length(root, notation); });
+        buffer.resize(length);
+        size_t written = 0;
+        double to_buffer = Milliseconds([&] { written = TreeEmitter::Write(root, notation, buffer.data()); });
+        double to_file = Milliseconds([&] { emitter.Write(root, notation, fd); });
+
+        if (written != length) {
+            cerr << "Длина " << written << " не совпала с рассчитанной " << length << endl;
+            return 1;
+        }
+        cout << name << ": " << length << " байт, длина " << measure << " мс, в буфер " << to_buffer
+             << " мс, в файл " << to_file << " мс (" << tokens / to_file / 1e3 << " млн токенов/с)\n";
+    }
+
+    close(fd);
+    return 0;
+}
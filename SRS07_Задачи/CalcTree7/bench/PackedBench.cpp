@@ -0,0 +1,87 @@
+/**
+ * @file PackedBench.cpp
+ * @brief Скорость упаковки и распаковки выражения в сравнении с текстом
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/PackedBench.cpp perplexity/PackedExpression.cpp \
+ *       perplexity/ExpressionTree.cpp perplexity/TreeEmitter.cpp perplexity/WorkStealingScheduler.cpp \
+ *       -o packed_bench
+ * Запуск: ./packed_bench expression-file
+ *
+ * Печатаются размеры текстовой и упакованной форм и время: разбора текста,
+ * упаковки дерева и токенов, контрольной суммы, распаковки в токены и
+ * распаковки с построением дерева. Распакованные токены должны совпасть с
+ * разобранными из текста, иначе программа завершается с ошибкой.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ExpressionTree.h"
+#include "PackedExpression.h"
+
+using namespace std;
+
+/**
+ * @brief Время выполнения функции в миллисекундах
+ */
+template <typename Function>
+double Milliseconds(Function&& function) {
+    auto t0 = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * @brief Строка с временем и пропускной способностью по упакованным данным
+ */
+void Report(const char* name, double ms, size_t bytes, size_t tokens) {
+    cout << name << ": " << ms << " мс, " << bytes / ms / 1e3 << " МБ/с, " << tokens / ms / 1e3
+         << " млн токенов/с\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " expression-file" << endl;
+        return 1;
+    }
+
+    vector<long long> tokens;
+    double parse = Milliseconds([&] { tokens = ExpressionTree::ReadExpression(argv[1]); });
+    ExpressionTree tree(tokens);
+
+    string text;
+    tree.AppendPrefix(text);
+
+    vector<unsigned char> packed;
+    double encode_tree = Milliseconds([&] { packed = PackedExpression::Encode(tree); });
+    double encode_tokens = Milliseconds([&] { packed = PackedExpression::Encode(tokens); });
+    uint64_t sum = 0;
+    double checksum = Milliseconds([&] { sum = PackedExpression::Checksum(packed.data(), packed.size()); });
+
+    vector<long long> decoded;
+    bool ok = false;
+    double decode = Milliseconds([&] { ok = PackedExpression::Decode(packed.data(), packed.size(), decoded); });
+    if (!ok || decoded != tokens) {
+        cerr << "Распакованные токены не совпали с исходными" << endl;
+        return 1;
+    }
+    ExpressionTree rebuilt;
+    double decode_build = Milliseconds([&] {
+        PackedExpression::Decode(packed.data(), packed.size(), decoded);
+        rebuilt.Assign(decoded);
+    });
+
+    size_t n = tokens.size();
+    cout << "Токенов: " << n << ", текст " << text.size() << " байт, упаковано " << packed.size()
+         << " байт (сумма " << hex << sum << dec << ")\n";
+    cout << "разбор текста (файл): " << parse << " мс\n";
+    Report("упаковка дерева", encode_tree, packed.size(), n);
+    Report("упаковка токенов", encode_tokens, packed.size(), n);
+    Report("контрольная сумма", checksum, packed.size(), n);
+    Report("распаковка в токены", decode, packed.size(), n);
+    Report("распаковка и построение дерева", decode_build, packed.size(), n);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ParallelBench.cpp
+ * @brief Сравнение последовательных и параллельных вычисления и свертки дерева
+ *
+ * Сборка (из каталога CalcTree7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/ParallelBench.cpp \
+ *       perplexity/ExpressionTree.cpp perplexity/TreeEmitter.cpp perplexity/WorkStealingScheduler.cpp \
+ *       -o parallel_bench
+ * Запуск: ./parallel_bench expression-file [threads] [grain]
+ *
+ * Файл читается в два дерева: одно обрабатывается последовательно, другое —
+ * планировщиком с перехватом работы. Печатается время каждого шага; значения и
+ * свернутые деревья должны совпасть, иначе программа завершается с ошибкой.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "ExpressionTree.h"
+
+using namespace std;
+
+/**
+ * @brief Время выполнения функции в миллисекундах
+ */
+template <typename Function>
+double Milliseconds(Function&& function) {
+    auto t0 = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * @brief Совпадают ли деревья узел в узел (без рекурсии)
+ */
+bool SameTree(const TreeNode* a, const TreeNode* b) {
+    vector<pair<const TreeNode*, const TreeNode*>> st{{a, b}};
+    while (!st.empty()) {
+        auto [x, y] = st.back(); st.pop_back();
+        if (!x || !y) {
+            if (x != y) return false;
+            continue;
+        }
+        if (x->value != y->value) return false;
+        st.push_back({x->right, y->right});
+        st.push_back({x->left, y->left});
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Использование: " << argv[0] << " expression-file [threads] [grain]" << endl;
+        return 1;
+    }
+    unsigned threads = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 0;
+    size_t grain = argc > 3 ? strtoull(argv[3], nullptr, 10) : ExpressionTree::PARALLEL_GRAIN;
+
+    ExpressionTree sequential(argv[1]);
+    ExpressionTree parallel(argv[1]);
+
+    long long sequential_value = 0;
+    long long parallel_value = 0;
+    double evaluate_seq = Milliseconds([&] { sequential_value = sequential.Evaluate(); });
+    double evaluate_par = Milliseconds([&] { parallel_value = parallel.EvaluateParallel(threads, grain); });
+    if (sequential_value != parallel_value) {
+        cerr << "Значения различаются: " << sequential_value << " и " << parallel_value << endl;
+        return 1;
+    }
+
+    double fold_seq = Milliseconds([&] { sequential.TransformTree(); });
+    double fold_par = Milliseconds([&] { parallel.TransformTreeParallel(threads, grain); });
+    if (!SameTree(sequential.Root(), parallel.Root())) {
+        cerr << "Свернутые деревья различаются" << endl;
+        return 1;
+    }
+
+    cout << "Значение: " << sequential_value << '\n';
+    cout << "Вычисление: " << evaluate_seq << " мс последовательно, " << evaluate_par
+         << " мс параллельно (ускорение " << evaluate_seq / evaluate_par << "x)\n";
+    cout << "Свертка: " << fold_seq << " мс последовательно, " << fold_par
+         << " мс параллельно (ускорение " << fold_seq / fold_par << "x)\n";
+    return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file BatchRunner.h
+ * @brief Общая для всех вариантов часть пакетного режима: входы, части файлов, пул потоков и упорядоченный вывод
+ *
+ * Только заголовок, чтобы каждый вариант по-прежнему собирался из своего каталога.
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Обработка строк многих файлов пулом потоков с выводом в порядке входов
+ *
+ * Вход — каталог (все обычные файлы в порядке имен), шаблон glob или файл.
+ * Файлы крупнее CHUNK_BYTES делятся на части; строка принадлежит части, в
+ * которой она начинается. Что делать со строкой, решает функция варианта;
+ * у каждого потока свое состояние State (дерево или пул узлов), которое
+ * переиспользуется между строками.
+ */
+class BatchRunner {
+public:
+    /// Итог обработки одной строки
+    enum LineStatus {
+        EMPTY,      ///< выражения в строке нет
+        DONE,       ///< выражение преобразовано, результат дописан
+        MALFORMED   ///< операции не хватает операндов
+    };
+
+    /// Файлы крупнее делятся на части, чтобы строки одного файла обрабатывали разные потоки
+    static constexpr std::size_t CHUNK_BYTES = std::size_t{1} << 20;
+
+    /// Вывод копится и сбрасывается записями не меньше этого размера
+    static constexpr std::size_t FLUSH_BYTES = std::size_t{1} << 20;
+
+    /**
+     * @brief Раскрывает входы в список частей файлов
+     * @param inputs Каталоги, шаблоны или файлы
+     */
+    explicit BatchRunner(const std::vector<std::string>& inputs);
+
+    /**
+     * @brief Число частей файлов, на которые поделена работа
+     */
+    std::size_t ItemCount() const {
+        return items.size();
+    }
+
+    /**
+     * @brief Обрабатывает все строки и выводит результаты по порядку
+     *
+     * Некорректное выражение — ошибка с именем файла и номером строки.
+     * @param threads Число потоков (0 — по числу ядер)
+     * @param fd Дескриптор вывода
+     * @param process Функция LineStatus(State&, const char* begin, const char* end, std::string& out)
+     * @return Число обработанных выражений
+     */
+    template <typename State, typename Process>
+    std::size_t Run(unsigned threads, int fd, Process process) const;
+
+private:
+    /// Часть файла: строки, начинающиеся в [begin, end)
+    struct Item {
+        std::string path;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    std::vector<Item> items;
+
+    static void ListDirectory(const std::string& dir, std::vector<std::string>& files);
+    static std::vector<std::string> ExpandInputs(const std::vector<std::string>& inputs);
+    static void ReportMalformed(const std::string& path, const char* text, const char* line);
+    static void WriteAll(int fd, const std::string& data);
+
+    /**
+     * @brief Обрабатывает строки части файла, дописывая результаты в out
+     * @return Число выражений
+     */
+    template <typename State, typename Process>
+    static std::size_t ProcessItem(const Item& item, State& state, Process& process, std::string& out);
+};
+
+inline BatchRunner::BatchRunner(const std::vector<std::string>& inputs) {
+    for (const std::string& path : ExpandInputs(inputs)) {
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode) &&
+            static_cast<std::size_t>(info.st_size) > CHUNK_BYTES) {
+            std::size_t size = static_cast<std::size_t>(info.st_size);
+            for (std::size_t begin = 0; begin < size; begin += CHUNK_BYTES) {
+                items.push_back({path, begin, std::min(size, begin + CHUNK_BYTES)});
+            }
+        } else {
+            items.push_back({path, 0, SIZE_MAX});
+        }
+    }
+}
+
+/**
+ * @brief Обычные файлы каталога в порядке имен (скрытые пропускаются)
+ */
+inline void BatchRunner::ListDirectory(const std::string& dir, std::vector<std::string>& files) {
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) {
+        std::cerr << "Не удалось открыть каталог: " << dir << std::endl;
+        std::exit(1);
+    }
+
+    std::vector<std::string> names;
+    while (dirent* entry = readdir(handle)) {
+        if (entry->d_name[0] == '.') continue;
+        std::string path = dir + '/' + entry->d_name;
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) names.push_back(path);
+    }
+    closedir(handle);
+
+    std::sort(names.begin(), names.end());
+    files.insert(files.end(), names.begin(), names.end());
+}
+
+/**
+ * @brief Раскрывает шаблоны и каталоги в список файлов
+ */
+inline std::vector<std::string> BatchRunner::ExpandInputs(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        std::vector<std::string> paths;
+        if (input.find_first_of("*?[") != std::string::npos) {
+            glob_t found;
+            if (glob(input.c_str(), 0, nullptr, &found) == 0) {
+                paths.assign(found.gl_pathv, found.gl_pathv + found.gl_pathc);
+            }
+            globfree(&found);
+            if (paths.empty()) {
+                std::cerr << "Нет файлов по шаблону: " << input << std::endl;
+                std::exit(1);
+            }
+        } else {
+            paths.push_back(input);
+        }
+
+        for (const std::string& path : paths) {
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0) {
+                std::cerr << "Не удалось открыть файл: " << path << std::endl;
+                std::exit(1);
+            }
+            if (S_ISDIR(info.st_mode)) {
+                ListDirectory(path, files);
+            } else {
+                files.push_back(path);
+            }
+        }
+    }
+    return files;
+}
+
+/**
+ * @brief Сообщает о некорректном выражении с именем файла и номером строки и завершает программу
+ * @param text Начало файла, от которого считаются строки
+ * @param line Начало строки с выражением
+ */
+inline void BatchRunner::ReportMalformed(const std::string& path, const char* text, const char* line) {
+    std::size_t number = 1 + static_cast<std::size_t>(std::count(text, line, '\n'));
+    std::cerr << "Некорректное выражение: не хватает операндов (" << path << ", строка " << number << ")"
+              << std::endl;
+    std::exit(1);
+}
+
+/**
+ * @brief Записывает весь буфер, повторяя write при частичной записи
+ */
+inline void BatchRunner::WriteAll(int fd, const std::string& data) {
+    std::size_t done = 0;
+    while (done < data.size()) {
+        ssize_t written = write(fd, data.data() + done, data.size() - done);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Ошибка записи результата" << std::endl;
+            std::exit(1);
+        }
+        done += static_cast<std::size_t>(written);
+    }
+}
+
+template <typename State, typename Process>
+std::size_t BatchRunner::ProcessItem(const Item& item, State& state, Process& process, std::string& out) {
+    int fd = open(item.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Не удалось открыть файл: " << item.path << std::endl;
+        std::exit(1);
+    }
+
+    // Целый файл отображается с подкачкой сразу, часть — по мере чтения
+    const char* text = nullptr;
+    std::size_t size = 0;
+    void* mapped = MAP_FAILED;
+    std::string buffer;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        size = static_cast<std::size_t>(info.st_size);
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (item.begin == 0 && item.end >= size) flags |= MAP_POPULATE;
+#endif
+        if (size > 0) mapped = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+        if (mapped != MAP_FAILED) {
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            text = static_cast<const char*>(mapped);
+        }
+    }
+    if (!text) {
+        char chunk[1 << 16];
+        ssize_t got;
+        while ((got = read(fd, chunk, sizeof(chunk))) > 0) buffer.append(chunk, static_cast<std::size_t>(got));
+        text = buffer.data();
+        size = buffer.size();
+    }
+    close(fd);
+
+    // Строка принадлежит части, в которой она начинается
+    std::size_t begin = std::min(item.begin, size);
+    std::size_t end = std::min(item.end, size);
+    if (begin > 0) {
+        const void* newline = std::memchr(text + begin - 1, '\n', end - begin + 1);
+        begin = newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - text) + 1 : end;
+    }
+
+    std::size_t count = 0;
+    const char* p = text + begin;
+    const char* file_end = text + size;
+    while (p < text + end) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(file_end - p)));
+        const char* line_end = newline ? newline : file_end;
+        LineStatus status = process(state, p, line_end, out);
+        if (status == MALFORMED) ReportMalformed(item.path, text, p);
+        if (status == DONE) ++count;
+        if (!newline) break;
+        p = newline + 1;
+    }
+
+    if (mapped != MAP_FAILED) munmap(mapped, size);
+    return count;
+}
+
+template <typename State, typename Process>
+std::size_t BatchRunner::Run(unsigned threads, int fd, Process process) const {
+    if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> outputs(items.size());
+    std::vector<char> ready(items.size(), 0);
+    std::mutex ready_mutex;
+    std::condition_variable ready_changed;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> expressions{0};
+
+    auto process_next = [&](State& state) {
+        std::size_t i = next.fetch_add(1);
+        if (i >= items.size()) return false;
+        std::string out;
+        expressions += ProcessItem(items[i], state, process, out);
+        {
+            std::lock_guard<std::mutex> lock(ready_mutex);
+            outputs[i] = std::move(out);
+            ready[i] = 1;
+        }
+        ready_changed.notify_one();
+        return true;
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back([&] {
+            State state;
+            while (process_next(state)) {}
+        });
+    }
+
+    // Главный поток выводит части по порядку, а пока очередная не готова — обрабатывает сам
+    State state;
+    std::string buffer;
+    for (std::size_t written = 0; written < items.size(); ++written) {
+        std::unique_lock<std::mutex> lock(ready_mutex);
+        while (!ready[written]) {
+            lock.unlock();
+            bool worked = process_next(state);
+            lock.lock();
+            if (!worked) ready_changed.wait(lock, [&] { return ready[written] != 0; });
+        }
+        std::string out = std::move(outputs[written]);
+        outputs[written] = std::string();
+        lock.unlock();
+
+        // Большой результат пишется сразу, без копирования в буфер
+        if (buffer.size() + out.size() >= FLUSH_BYTES) {
+            WriteAll(fd, buffer);
+            buffer.clear();
+        }
+        if (out.size() >= FLUSH_BYTES) {
+            WriteAll(fd, out);
+        } else {
+            buffer += out;
+        }
+    }
+    WriteAll(fd, buffer);
+
+    for (auto& t : pool) t.join();
+    return expressions;
+}
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,228 @@
+/**
+ * @file ExpressionReader.h
+ * @brief Общий для всех вариантов разбор текста выражения в токены и чтение файла
+ *
+ * Только заголовок, чтобы каждый вариант по-прежнему собирался из своего каталога.
+ */
+
+#ifndef EXPRESSIONREADER_H
+#define EXPRESSIONREADER_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Код переменной x0; переменная xk кодируется как FIRST_VARIABLE - k
+ */
+const long long FIRST_VARIABLE = -7;
+
+namespace expression_reader_detail {
+
+/**
+ * @brief Класс байта входного файла
+ */
+enum ByteClass : unsigned char {
+    BYTE_OTHER = 0,  // игнорируется, как и прежде
+    BYTE_SPACE,
+    BYTE_DIGIT,
+    BYTE_OPERATION,
+    BYTE_VARIABLE
+};
+
+/**
+ * @brief Таблица разбора: класс каждого из 256 байтов и код операции для знаков
+ */
+struct ByteTable {
+    unsigned char kind[256];
+    signed char code[256];
+};
+
+constexpr ByteTable MakeByteTable() {
+    ByteTable table{};
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) table.kind[static_cast<unsigned char>(c)] = BYTE_SPACE;
+    for (char c = '0'; c <= '9'; ++c) table.kind[static_cast<unsigned char>(c)] = BYTE_DIGIT;
+    const char signs[] = {'+', '-', '*', '/', '%', '^'};
+    for (int i = 0; i < 6; ++i) {
+        table.kind[static_cast<unsigned char>(signs[i])] = BYTE_OPERATION;
+        table.code[static_cast<unsigned char>(signs[i])] = static_cast<signed char>(-1 - i);
+    }
+    table.kind[static_cast<unsigned char>('x')] = BYTE_VARIABLE;
+    return table;
+}
+
+inline constexpr ByteTable BYTE_TABLE = MakeByteTable();
+
+} // namespace expression_reader_detail
+
+/**
+ * @brief Разбор префиксной записи: числа, знаки операций и (по запросу) переменные
+ *
+ * Токены — неотрицательные числа, коды операций -1..-6 ('+' ... '^') и коды
+ * переменных FIRST_VARIABLE - k. Разбор идет за один проход по таблице
+ * классов байтов; прочие символы игнорируются.
+ */
+class ExpressionReader {
+public:
+    /**
+     * @brief Разбирает выражение из буфера в памяти
+     * @param begin Начало текста
+     * @param end Конец текста
+     * @param allow_variables Разбирать ли переменные вида x0, x1, ... (иначе 'x' игнорируется)
+     * @return Вектор токенов выражения
+     */
+    static std::vector<long long> Parse(const char* begin, const char* end, bool allow_variables = false);
+
+    /**
+     * @brief Читает и разбирает выражение из файла
+     *
+     * Обычный файл отображается в память, каналы и специальные файлы читаются целиком.
+     * @param file_name Имя файла
+     * @param allow_variables Разбирать ли переменные вида x0, x1, ...
+     * @return Вектор токенов выражения
+     */
+    static std::vector<long long> Read(const std::string& file_name, bool allow_variables = false);
+
+private:
+    static const char* SkipSpaces(const char* p, const char* end);
+    static long long ParseNumber(const char*& p, const char* end);
+};
+
+/**
+ * @brief Пропускает пробельные символы, по 16 байт за шаг при наличии SSE2
+ */
+inline const char* ExpressionReader::SkipSpaces(const char* p, const char* end) {
+    using namespace expression_reader_detail;
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i span = _mm_set1_epi8('\r' - '\t');
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // '\t'..'\r' — это (byte - '\t') <= 4 без знака
+        __m128i shifted = _mm_sub_epi8(bytes, tab);
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, span), shifted);
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(bytes, space), control);
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFFu;
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && BYTE_TABLE.kind[static_cast<unsigned char>(*p)] == BYTE_SPACE) ++p;
+    return p;
+}
+
+/**
+ * @brief Читает неотрицательное число из цифр, начиная с p
+ */
+inline long long ExpressionReader::ParseNumber(const char*& p, const char* end) {
+    using namespace expression_reader_detail;
+    long long number = 0;
+    do {
+        int digit = *p - '0';
+        // Точная проверка переполнения нужна только для самых длинных чисел
+        if (number >= LLONG_MAX / 10 && number > (LLONG_MAX - digit) / 10) {
+            std::cerr << "Слишком большое число в выражении" << std::endl;
+            std::exit(1);
+        }
+        number = number * 10 + digit;
+        ++p;
+    } while (p < end && BYTE_TABLE.kind[static_cast<unsigned char>(*p)] == BYTE_DIGIT);
+    return number;
+}
+
+inline std::vector<long long> ExpressionReader::Parse(const char* p, const char* end, bool allow_variables) {
+    using namespace expression_reader_detail;
+    std::vector<long long> tokens;
+    tokens.reserve(static_cast<std::size_t>(end - p) / 2 + 1);
+
+    while (p < end) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        switch (BYTE_TABLE.kind[c]) {
+            case BYTE_SPACE:
+                // Обычно между токенами один пробел — длинные серии пропускаются блоками
+                ++p;
+                if (p < end && BYTE_TABLE.kind[static_cast<unsigned char>(*p)] == BYTE_SPACE) p = SkipSpaces(p, end);
+                break;
+            case BYTE_DIGIT:
+                tokens.push_back(ParseNumber(p, end));
+                break;
+            case BYTE_VARIABLE: {
+                ++p;
+                if (!allow_variables) break;
+                if (p == end || BYTE_TABLE.kind[static_cast<unsigned char>(*p)] != BYTE_DIGIT) {
+                    std::cerr << "Ожидался номер переменной после 'x'" << std::endl;
+                    std::exit(1);
+                }
+                long long index = ParseNumber(p, end);
+                if (index > INT_MAX) {
+                    std::cerr << "Слишком большой номер переменной" << std::endl;
+                    std::exit(1);
+                }
+                tokens.push_back(FIRST_VARIABLE - index);
+                break;
+            }
+            case BYTE_OPERATION:
+                tokens.push_back(BYTE_TABLE.code[c]);
+                ++p;
+                break;
+            default:
+                ++p;
+                break;
+        }
+    }
+
+    return tokens;
+}
+
+inline std::vector<long long> ExpressionReader::Read(const std::string& file_name, bool allow_variables) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Не удалось открыть файл: " << file_name << std::endl;
+        std::exit(1);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        if (size == 0) {
+            close(fd);
+            return {};
+        }
+#ifdef MAP_POPULATE
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+#else
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+#endif
+        if (data != MAP_FAILED) {
+            madvise(data, size, MADV_SEQUENTIAL);
+            const char* text = static_cast<const char*>(data);
+            std::vector<long long> tokens = Parse(text, text + size, allow_variables);
+            munmap(data, size);
+            close(fd);
+            return tokens;
+        }
+    }
+
+    // Каналы и специальные файлы читаются в память целиком
+    std::string text;
+    char chunk[1 << 16];
+    ssize_t got;
+    while ((got = read(fd, chunk, sizeof(chunk))) > 0) text.append(chunk, static_cast<std::size_t>(got));
+    close(fd);
+    return Parse(text.data(), text.data() + text.size(), allow_variables);
+}
+
+#endif // EXPRESSIONREADER_H
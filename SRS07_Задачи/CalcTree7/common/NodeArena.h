@@ -0,0 +1,97 @@
+/**
+ * @file NodeArena.h
+ * @brief Общий для всех вариантов пул узлов дерева выражения
+ *
+ * Только заголовок, чтобы каждый вариант по-прежнему собирался из своего каталога.
+ */
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Пул узлов: узлы выделяются подряд из больших блоков и освобождаются все сразу
+ *
+ * Отброшенные при преобразовании поддеревья не освобождаются по одному —
+ * память возвращается целиком при Clear() или уничтожении пула. Каждый
+ * вариант задает свой тип узла: using NodeArena = BasicNodeArena<TreeNode>.
+ * @tparam Node Узел, конструируемый из значения long long
+ */
+template <typename Node>
+class BasicNodeArena {
+public:
+    /**
+     * @brief Конструктор пула
+     * @param first_block Число узлов в первом блоке (следующие блоки вдвое больше)
+     */
+    explicit BasicNodeArena(std::size_t first_block = 4096) : block_size(std::max<std::size_t>(first_block, 1)) {}
+
+    BasicNodeArena(const BasicNodeArena&) = delete;
+    BasicNodeArena& operator=(const BasicNodeArena&) = delete;
+    BasicNodeArena(BasicNodeArena&&) = default;
+    BasicNodeArena& operator=(BasicNodeArena&&) = default;
+
+    /**
+     * @brief Гарантирует, что следующие needed узлов поместятся в один блок
+     * @param needed Число узлов
+     */
+    void Reserve(std::size_t needed) {
+        if (blocks.empty() || blocks.back().capacity() - blocks.back().size() < needed) {
+            AddBlock(std::max(needed, block_size));
+        }
+    }
+
+    /**
+     * @brief Создает узел в пуле
+     * @param val Значение узла
+     * @return Указатель на узел, действительный до Clear()
+     */
+    Node* Create(long long val) {
+        // Блок не растет сверх зарезервированного, поэтому адреса узлов не меняются
+        if (blocks.empty() || blocks.back().size() == blocks.back().capacity()) {
+            AddBlock(blocks.empty() ? block_size : blocks.back().capacity() * 2);
+        }
+        blocks.back().emplace_back(val);
+        ++count;
+        return &blocks.back().back();
+    }
+
+    /**
+     * @brief Освобождает все узлы; самый большой блок остается для повторного использования
+     */
+    void Clear() {
+        // Следующее дерево того же размера строится без выделений памяти
+        if (!blocks.empty()) {
+            auto largest = std::max_element(blocks.begin(), blocks.end(),
+                [](const std::vector<Node>& a, const std::vector<Node>& b) { return a.capacity() < b.capacity(); });
+            std::vector<Node> kept = std::move(*largest);
+            kept.clear();
+            blocks.clear();
+            blocks.push_back(std::move(kept));
+        }
+        count = 0;
+    }
+
+    /**
+     * @brief Количество созданных узлов
+     */
+    std::size_t Size() const {
+        return count;
+    }
+
+private:
+    std::vector<std::vector<Node>> blocks;
+    std::size_t block_size;
+    std::size_t count = 0;
+
+    void AddBlock(std::size_t capacity) {
+        blocks.emplace_back();
+        blocks.back().reserve(capacity);
+    }
+};
+
+#endif // NODEARENA_H
@@ -0,0 +1,29 @@
+/**
+ * @file BatchMode.h
+ * @brief Пакетная обработка множества выражений на пуле потоков
+ */
+
+#ifndef BATCHMODE_H
+#define BATCHMODE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Преобразует все выражения из заданных входов
+ *
+ * Вход — каталог (все обычные файлы в порядке имён), шаблон glob или файл;
+ * каждая непустая строка файла — отдельное выражение. Большие файлы делятся
+ * на части по строкам. Части обрабатываются пулом потоков, у каждого потока
+ * свой пул узлов; результаты выводятся в порядке входов теми же строками, что
+ * и в обычном режиме, крупными записями в дескриптор. Все это, кроме
+ * преобразования строки, — общий для вариантов BatchRunner.
+ * @param inputs Каталоги, шаблоны или файлы
+ * @param threads Число потоков (0 — по числу ядер)
+ * @param fd Дескриптор вывода
+ * @return Число обработанных выражений
+ */
+std::size_t runBatch(const std::vector<std::string>& inputs, unsigned threads = 0, int fd = 1);
+
+#endif // BATCHMODE_H
@@ -4,10 +4,11 @@
  */
 
 #include "CalcTree7.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <stack>
-#include <cctype>
+#include "../common/ExpressionReader.h"
 
 using namespace std;
 
@@ -23,121 +24,174 @@ const int POW = -6;
  * @brief Функциональный объект для проверки операции
  */
 struct IsOperation {
-    bool operator()(int val) const {
+    bool operator()(long long val) const {
         return val <= -1 && val >= -6;
     }
 };
 
-TreeNode::TreeNode(int val) : value(val), left(nullptr), right(nullptr) {}
-
-vector<int> readExpression(const string& filename) {
-    ifstream file(filename);
-    if (!file) {
-        cerr << "Не удалось открыть файл: " << filename << endl;
-        exit(1);
-    }
-    
-    vector<int> tokens;
-    char c;
-    while (file >> c) {
-        if (isdigit(static_cast<unsigned char>(c))) {
-            tokens.push_back(c - '0');
-        } else {
-            switch (c) {
-                case '+': tokens.push_back(ADD); break;
-                case '-': tokens.push_back(SUB); break;
-                case '*': tokens.push_back(MUL); break;
-                case '/': tokens.push_back(DIV); break;
-                case '%': tokens.push_back(MOD); break;
-                case '^': tokens.push_back(POW); break;
-                default: break;
+/**
+ * @brief Функциональный объект для применения операции к значениям операндов
+ */
+struct ApplyOperation {
+    long long operator()(long long op, long long left, long long right) const {
+        switch (op) {
+            case ADD: return left + right;
+            case SUB: return left - right;
+            case MUL: return left * right;
+            case DIV: return left / right;
+            case MOD: return left % right;
+            case POW: {
+                // Возведение в квадрат по битам показателя; при показателе <= 0 результат 1
+                unsigned long long result = 1;
+                unsigned long long factor = static_cast<unsigned long long>(left);
+                for (long long e = right; e > 0; e >>= 1) {
+                    if (e & 1) result *= factor;
+                    factor *= factor;
+                }
+                return static_cast<long long>(result);
             }
+            default: return 0;
         }
     }
-    
-    return tokens;
+};
+
+TreeNode::TreeNode(long long val) : value(val), left(nullptr), right(nullptr) {}
+
+vector<long long> parseExpression(const char* begin, const char* end) {
+    return ExpressionReader::Parse(begin, end);
+}
+
+vector<long long> readExpression(const string& filename) {
+    return ExpressionReader::Read(filename);
 }
 
-shared_ptr<TreeNode> buildTree(const vector<int>& tokens) {
-    stack<shared_ptr<TreeNode>> st;
+TreeNode* buildTree(const vector<long long>& tokens, NodeArena& arena) {
+    // Все узлы и стек построения занимают по одному выделению памяти
+    arena.Reserve(tokens.size());
+    vector<TreeNode*> st;
+    st.reserve(tokens.size());
     IsOperation isOp;
     
     for (auto it = tokens.rbegin(); it != tokens.rend(); ++it) {
-        int val = *it;
-        auto node = make_shared<TreeNode>(val);
+        long long val = *it;
+        TreeNode* node = arena.Create(val);
         
         if (isOp(val)) {
-            node->left = st.top(); st.pop();
-            node->right = st.top(); st.pop();
+            if (st.size() < 2) return nullptr;
+            node->left = st.back(); st.pop_back();
+            node->right = st.back(); st.pop_back();
         }
         
-        st.push(node);
+        st.push_back(node);
     }
     
-    return st.top();
+    return st.empty() ? nullptr : st.back();
 }
 
-int evaluateSubtree(shared_ptr<TreeNode> node) {
-    IsOperation isOp;
+/**
+ * @brief Собирает узлы поддерева в префиксном порядке без рекурсии
+ *
+ * В обратном порядке этого списка каждый узел идет после обоих своих детей,
+ * причем левый ребенок обрабатывается последним — это порядок стековой машины.
+ */
+template <typename Node>
+static vector<Node*> collectPreorder(Node* root) {
+    vector<Node*> order;
+    vector<Node*> st{root};
     
-    if (!isOp(node->value)) {
-        return node->value;
+    while (!st.empty()) {
+        Node* node = st.back(); st.pop_back();
+        order.push_back(node);
+        if (node->right) st.push_back(node->right);
+        if (node->left) st.push_back(node->left);
     }
     
-    int left = evaluateSubtree(node->left);
-    int right = evaluateSubtree(node->right);
+    return order;
+}
+
+long long evaluateSubtree(const TreeNode* node) {
+    IsOperation isOp;
+    ApplyOperation apply;
+    auto order = collectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
     
-    switch (node->value) {
-        case ADD: return left + right;
-        case SUB: return left - right;
-        case MUL: return left * right;
-        case DIV: return left / right;
-        case MOD: return left % right;
-        case POW: {
-            int result = 1;
-            for (int i = 0; i < right; ++i) result *= left;
-            return result;
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const TreeNode* current = *it;
+        if (isOp(current->value)) {
+            long long left = values.back(); values.pop_back();
+            long long right = values.back(); values.pop_back();
+            values.push_back(apply(current->value, left, right));
+        } else {
+            values.push_back(current->value);
         }
-        default: return 0;
     }
+    
+    return values.back();
 }
 
-void transformTree(shared_ptr<TreeNode>& node) {
+void transformTree(TreeNode* node) {
     if (!node) return;
     
     IsOperation isOp;
+    ApplyOperation apply;
+    auto order = collectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
     
-    transformTree(node->left);
-    transformTree(node->right);
-    
-    if (isOp(node->value)) {
-        int result = evaluateSubtree(node);
+    // Значение каждого узла вычисляется один раз и передается родителю через стек;
+    // свертка потомка не меняет значения предка
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        TreeNode* current = *it;
+        if (!isOp(current->value)) {
+            values.push_back(current->value);
+            continue;
+        }
+        
+        long long left = values.back(); values.pop_back();
+        long long right = values.back(); values.pop_back();
+        long long result = apply(current->value, left, right);
+        
         if (result >= 0 && result <= 9) {
-            node->value = result;
-            node->left = nullptr;
-            node->right = nullptr;
+            current->value = result;
+            current->left = nullptr;
+            current->right = nullptr;
         }
+        values.push_back(result);
     }
 }
 
-void printPrefix(shared_ptr<TreeNode> node) {
+void appendPrefix(const TreeNode* node, string& out) {
     if (!node) return;
     
     IsOperation isOp;
+    vector<const TreeNode*> st{node};
+    char digits[24];
     
-    if (isOp(node->value)) {
-        switch (node->value) {
-            case ADD: cout << "+ "; break;
-            case SUB: cout << "- "; break;
-            case MUL: cout << "* "; break;
-            case DIV: cout << "/ "; break;
-            case MOD: cout << "% "; break;
-            case POW: cout << "^ "; break;
+    while (!st.empty()) {
+        const TreeNode* current = st.back(); st.pop_back();
+        
+        if (isOp(current->value)) {
+            switch (current->value) {
+                case ADD: out += "+ "; break;
+                case SUB: out += "- "; break;
+                case MUL: out += "* "; break;
+                case DIV: out += "/ "; break;
+                case MOD: out += "% "; break;
+                case POW: out += "^ "; break;
+            }
+        } else {
+            out.append(digits, to_chars(digits, digits + sizeof(digits), current->value).ptr);
+            out += ' ';
         }
-    } else {
-        cout << node->value << " ";
+        
+        if (current->right) st.push_back(current->right);
+        if (current->left) st.push_back(current->left);
     }
-    
-    printPrefix(node->left);
-    printPrefix(node->right);
+}
+
+void printPrefix(const TreeNode* node) {
+    string text;
+    appendPrefix(node, text);
+    cout << text;
 }
@@ -3,17 +3,46 @@
  * @brief Точка входа в программу решения задачи CalcTree7 (функциональный стиль)
  */
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
+#include "BatchMode.h"
 #include "CalcTree7.h"
 
 int main(int argc, char* argv[]) {
+    // --batch: много выражений за один запуск, см. runBatch
+    if (argc >= 2 && std::string(argv[1]) == "--batch") {
+        unsigned threads = 0;
+        std::vector<std::string> inputs;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--threads=", 0) == 0) {
+                threads = static_cast<unsigned>(std::strtoul(arg.c_str() + 10, nullptr, 10));
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+        if (inputs.empty()) {
+            std::cerr << "Использование: " << argv[0] << " --batch [--threads=N] path..." << std::endl;
+            return 1;
+        }
+        runBatch(inputs, threads);
+        return 0;
+    }
+
     if (argc != 2) {
-        std::cerr << "Использование: " << argv[0] << " filename" << std::endl;
+        std::cerr << "Использование: " << argv[0] << " filename | --batch [--threads=N] path..." << std::endl;
         return 1;
     }
     
     auto tokens = readExpression(argv[1]);
-    auto root = buildTree(tokens);
+    NodeArena arena;
+    auto root = buildTree(tokens, arena);
+    if (!tokens.empty() && !root) {
+        std::cerr << "Некорректное выражение: не хватает операндов" << std::endl;
+        return 1;
+    }
     
     std::cout << "Исходное дерево (префиксная форма): ";
     printPrefix(root);
@@ -0,0 +1,38 @@
+/**
+ * @file BatchMode.cpp
+ * @brief Реализация пакетной обработки выражений
+ */
+
+#include "BatchMode.h"
+#include "CalcTree7.h"
+#include "../common/BatchRunner.h"
+
+using namespace std;
+
+/**
+ * @brief Преобразует одно выражение и дописывает результат в out
+ */
+static BatchRunner::LineStatus processExpression(NodeArena& arena, const char* begin, const char* end,
+                                                 string& out) {
+    vector<long long> tokens = parseExpression(begin, end);
+    if (tokens.empty()) return BatchRunner::EMPTY;
+
+    arena.Clear();
+    TreeNode* root = buildTree(tokens, arena);
+    if (!root) return BatchRunner::MALFORMED;
+
+    out += "Исходное дерево (префиксная форма): ";
+    appendPrefix(root, out);
+    out += '\n';
+
+    transformTree(root);
+
+    out += "Преобразованное дерево (префиксная форма): ";
+    appendPrefix(root, out);
+    out += '\n';
+    return BatchRunner::DONE;
+}
+
+size_t runBatch(const vector<string>& inputs, unsigned threads, int fd) {
+    return BatchRunner(inputs).Run<NodeArena>(threads, fd, processExpression);
+}
@@ -4,10 +4,11 @@
  */
 
 #include "CalcTree7.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <stack>
-#include <cctype>
+#include "../common/ExpressionReader.h"
 
 using namespace std;
 
@@ -19,118 +20,168 @@ const int DIV = -4;
 const int MOD = -5;
 const int POW = -6;
 
-TreeNode::TreeNode(int val) : value(val), left(nullptr), right(nullptr) {}
+TreeNode::TreeNode(long long val) : value(val), left(nullptr), right(nullptr) {}
 
-shared_ptr<TreeNode> createNode(int val) {
-    return make_shared<TreeNode>(val);
+TreeNode* createNode(NodeArena& arena, long long val) {
+    return arena.Create(val);
 }
 
-bool isOperation(int val) {
+bool isOperation(long long val) {
     return val <= -1 && val >= -6;
 }
 
-vector<int> readExpression(const string& filename) {
-    ifstream file(filename);
-    if (!file) {
-        cerr << "Не удалось открыть файл: " << filename << endl;
-        exit(1);
-    }
-
-    vector<int> tokens;
-    char c;
-    while (file >> c) {
-        if (isdigit(static_cast<unsigned char>(c))) {
-            tokens.push_back(c - '0');
-        } else {
-            switch (c) {
-                case '+': tokens.push_back(ADD); break;
-                case '-': tokens.push_back(SUB); break;
-                case '*': tokens.push_back(MUL); break;
-                case '/': tokens.push_back(DIV); break;
-                case '%': tokens.push_back(MOD); break;
-                case '^': tokens.push_back(POW); break;
-                default: break; // Игнорируем другие символы
-            }
-        }
-    }
+vector<long long> parseExpression(const char* begin, const char* end) {
+    return ExpressionReader::Parse(begin, end);
+}
 
-    return tokens;
+vector<long long> readExpression(const string& filename) {
+    return ExpressionReader::Read(filename);
 }
 
-shared_ptr<TreeNode> buildTree(const vector<int>& tokens) {
-    stack<shared_ptr<TreeNode>> st;
+TreeNode* buildTree(const vector<long long>& tokens, NodeArena& arena) {
+    // Узлы и стек занимают по одному блоку памяти
+    arena.Reserve(tokens.size());
+    vector<TreeNode*> st;
+    st.reserve(tokens.size());
 
     // Обрабатываем токены в обратном порядке для префиксной записи
     for (auto it = tokens.rbegin(); it != tokens.rend(); ++it) {
-        int val = *it;
-        auto node = createNode(val);
+        long long val = *it;
+        TreeNode* node = createNode(arena, val);
 
         if (isOperation(val)) {
-            node->left = st.top(); st.pop();
-            node->right = st.top(); st.pop();
+            if (st.size() < 2) return nullptr;
+            node->left = st.back(); st.pop_back();
+            node->right = st.back(); st.pop_back();
         }
 
-        st.push(node);
+        st.push_back(node);
     }
 
-    return st.top();
+    return st.empty() ? nullptr : st.back();
 }
 
-int evaluateSubtree(shared_ptr<TreeNode> node) {
-    if (!isOperation(node->value)) {
-        return node->value;
-    }
-
-    int left = evaluateSubtree(node->left);
-    int right = evaluateSubtree(node->right);
-
-    switch (node->value) {
+long long applyOperation(long long op, long long left, long long right) {
+    switch (op) {
         case ADD: return left + right;
         case SUB: return left - right;
         case MUL: return left * right;
         case DIV: return left / right;
         case MOD: return left % right;
         case POW: {
-            int result = 1;
-            for (int i = 0; i < right; ++i) result *= left;
-            return result;
+            // Возведение в квадрат по битам показателя; при показателе <= 0 результат 1
+            unsigned long long result = 1;
+            unsigned long long factor = static_cast<unsigned long long>(left);
+            for (long long e = right; e > 0; e >>= 1) {
+                if (e & 1) result *= factor;
+                factor *= factor;
+            }
+            return static_cast<long long>(result);
         }
         default: return 0;
     }
 }
 
-void transformTree(shared_ptr<TreeNode> node) {
-    if (!node) return;
+// Узлы поддерева в префиксном порядке, собранные без рекурсии. При проходе
+// с конца каждый узел встречается после своих детей, левый ребенок — последним.
+template <typename Node>
+static vector<Node*> collectPreorder(Node* root) {
+    vector<Node*> order;
+    vector<Node*> st{root};
+
+    while (!st.empty()) {
+        Node* node = st.back(); st.pop_back();
+        order.push_back(node);
+        if (node->right) st.push_back(node->right);
+        if (node->left) st.push_back(node->left);
+    }
+
+    return order;
+}
+
+long long evaluateSubtree(const TreeNode* node) {
+    vector<const TreeNode*> order = collectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const TreeNode* current = *it;
+        if (isOperation(current->value)) {
+            long long left = values.back(); values.pop_back();
+            long long right = values.back(); values.pop_back();
+            values.push_back(applyOperation(current->value, left, right));
+        } else {
+            values.push_back(current->value);
+        }
+    }
+
+    return values.back();
+}
+
+long long foldSubtree(TreeNode* node) {
+    vector<TreeNode*> order = collectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
+
+    // Значения детей берутся со стека, поддерево заново не вычисляется
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        TreeNode* current = *it;
+        if (!isOperation(current->value)) {
+            values.push_back(current->value);
+            continue;
+        }
 
-    transformTree(node->left);
-    transformTree(node->right);
+        long long left = values.back(); values.pop_back();
+        long long right = values.back(); values.pop_back();
+        long long result = applyOperation(current->value, left, right);
 
-    if (isOperation(node->value)) {
-        int result = evaluateSubtree(node);
         if (result >= 0 && result <= 9) {
-            node->value = result;
-            node->left = nullptr;
-            node->right = nullptr;
+            current->value = result;
+            current->left = nullptr;
+            current->right = nullptr;
         }
+        values.push_back(result);
     }
+
+    return values.back();
 }
 
-void printPrefix(shared_ptr<TreeNode> node) {
+void transformTree(TreeNode* node) {
     if (!node) return;
 
-    if (isOperation(node->value)) {
-        switch (node->value) {
-            case ADD: cout << "+ "; break;
-            case SUB: cout << "- "; break;
-            case MUL: cout << "* "; break;
-            case DIV: cout << "/ "; break;
-            case MOD: cout << "% "; break;
-            case POW: cout << "^ "; break;
+    foldSubtree(node);
+}
+
+void appendPrefix(const TreeNode* node, string& out) {
+    if (!node) return;
+
+    vector<const TreeNode*> st{node};
+    char digits[24];
+    while (!st.empty()) {
+        const TreeNode* current = st.back(); st.pop_back();
+
+        if (isOperation(current->value)) {
+            switch (current->value) {
+                case ADD: out += "+ "; break;
+                case SUB: out += "- "; break;
+                case MUL: out += "* "; break;
+                case DIV: out += "/ "; break;
+                case MOD: out += "% "; break;
+                case POW: out += "^ "; break;
+            }
+        } else {
+            out.append(digits, to_chars(digits, digits + sizeof(digits), current->value).ptr);
+            out += ' ';
         }
-    } else {
-        cout << node->value << " ";
+
+        // Правый ребенок кладется первым, чтобы левый был выведен раньше
+        if (current->right) st.push_back(current->right);
+        if (current->left) st.push_back(current->left);
     }
+}
 
-    printPrefix(node->left);
-    printPrefix(node->right);
+void printPrefix(const TreeNode* node) {
+    string text;
+    appendPrefix(node, text);
+    cout << text;
 }
@@ -6,69 +6,116 @@
 #ifndef CALCTREE7_H
 #define CALCTREE7_H
 
-#include <memory>
+#include <cstddef>
+#include <string>
 #include <vector>
+#include "../common/NodeArena.h"
 
 /**
  * @brief Узел дерева выражения
+ *
+ * Узлы принадлежат пулу NodeArena, поэтому ссылки на детей — обычные указатели.
  */
 struct TreeNode {
-    int value;
-    std::shared_ptr<TreeNode> left;
-    std::shared_ptr<TreeNode> right;
+    long long value;
+    TreeNode* left;
+    TreeNode* right;
 
     /**
      * @brief Конструктор узла дерева
      * @param val Значение узла
      */
-    explicit TreeNode(int val);
+    explicit TreeNode(long long val);
 };
 
+/// Пул узлов дерева (общий для вариантов, см. common/NodeArena.h)
+using NodeArena = BasicNodeArena<TreeNode>;
+
 /**
  * @brief Создает новый узел дерева
+ * @param arena Пул, в котором создается узел
  * @param val Значение узла
  * @return Указатель на созданный узел
  */
-std::shared_ptr<TreeNode> createNode(int val);
+TreeNode* createNode(NodeArena& arena, long long val);
 
 /**
  * @brief Проверяет, является ли значение кодом операции
  * @param val Проверяемое значение
  * @return true если это операция, иначе false
  */
-bool isOperation(int val);
+bool isOperation(long long val);
 
 /**
  * @brief Читает выражение из файла
+ *
+ * Файл отображается в память и разбирается за один проход по таблице классов
+ * байтов; операнды — неотрицательные целые любой длины в пределах long long.
  * @param filename Имя файла
  * @return Вектор токенов выражения
  */
-std::vector<int> readExpression(const std::string& filename);
+std::vector<long long> readExpression(const std::string& filename);
+
+/**
+ * @brief Разбирает выражение из буфера в памяти
+ * @param begin Начало текста
+ * @param end Конец текста
+ * @return Вектор токенов выражения
+ */
+std::vector<long long> parseExpression(const char* begin, const char* end);
 
 /**
  * @brief Строит дерево выражения из префиксной формы
  * @param tokens Вектор токенов
- * @return Указатель на корень дерева
+ * @param arena Пул, в котором создаются узлы
+ * @return Указатель на корень дерева; nullptr, если токенов нет или операции
+ *         не хватает операндов
  */
-std::shared_ptr<TreeNode> buildTree(const std::vector<int>& tokens);
+TreeNode* buildTree(const std::vector<long long>& tokens, NodeArena& arena);
+
+/**
+ * @brief Применяет операцию к значениям операндов
+ * @param op Код операции
+ * @param left Значение левого операнда
+ * @param right Значение правого операнда
+ * @return Результат операции
+ */
+long long applyOperation(long long op, long long left, long long right);
 
 /**
  * @brief Вычисляет значение поддерева
  * @param node Корень поддерева
  * @return Значение поддерева
  */
-int evaluateSubtree(std::shared_ptr<TreeNode> node);
+long long evaluateSubtree(const TreeNode* node);
+
+/**
+ * @brief Сворачивает поддерево за один проход снизу вверх
+ *
+ * Значение каждого узла вычисляется один раз и передается родителю;
+ * узлы со значением 0-9 заменяются листьями.
+ * @param node Корень поддерева
+ * @return Значение поддерева
+ */
+long long foldSubtree(TreeNode* node);
 
 /**
  * @brief Преобразует дерево, заменяя поддеревья с результатами 0-9 на листья
  * @param node Корень дерева
  */
-void transformTree(std::shared_ptr<TreeNode> node);
+void transformTree(TreeNode* node);
 
 /**
  * @brief Выводит дерево в префиксной форме
  * @param node Корень дерева
  */
-void printPrefix(std::shared_ptr<TreeNode> node);
+void printPrefix(const TreeNode* node);
+
+/**
+ * @brief Дописывает префиксную форму дерева в строку (токены через пробел)
+ * @param node Корень дерева
+ * @param out Строка-приемник
+ */
+void appendPrefix(const TreeNode* node, std::string& out);
 
 #endif // CALCTREE7_H
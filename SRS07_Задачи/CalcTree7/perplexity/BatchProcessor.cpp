@@ -0,0 +1,44 @@
+/**
+ * @file BatchProcessor.cpp
+ * @brief Реализация пакетной обработки выражений
+ */
+
+#include "BatchProcessor.h"
+#include "ExpressionTree.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Преобразует одно выражение и дописывает результат в out
+ */
+BatchRunner::LineStatus ProcessExpression(ExpressionTree& tree, const char* begin, const char* end, string& out) {
+    vector<long long> tokens = ExpressionTree::ParseExpression(begin, end);
+    if (tokens.empty()) return BatchRunner::EMPTY;
+
+    if (!tree.Assign(tokens)) return BatchRunner::MALFORMED;
+
+    out += "Исходное дерево (префиксная форма): ";
+    tree.AppendPrefix(out);
+    out += '\n';
+
+    tree.TransformTree();
+
+    out += "Преобразованное дерево (префиксная форма): ";
+    tree.AppendPrefix(out);
+    out += '\n';
+    return BatchRunner::DONE;
+}
+
+} // namespace
+
+BatchProcessor::BatchProcessor(const vector<string>& inputs) : runner(inputs) {}
+
+size_t BatchProcessor::ItemCount() const {
+    return runner.ItemCount();
+}
+
+size_t BatchProcessor::Run(unsigned threads, int fd) const {
+    return runner.Run<ExpressionTree>(threads, fd, ProcessExpression);
+}
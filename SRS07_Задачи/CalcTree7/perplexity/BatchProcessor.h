@@ -0,0 +1,50 @@
+/**
+ * @file BatchProcessor.h
+ * @brief Пакетная обработка множества выражений на пуле потоков
+ */
+
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "../common/BatchRunner.h"
+
+/**
+ * @brief Преобразование выражений из многих файлов за один запуск
+ *
+ * Вход — каталог (все обычные файлы в порядке имен), шаблон glob или файл;
+ * каждая непустая строка файла — отдельное выражение. Большие файлы делятся на
+ * части по строкам. Части обрабатываются пулом потоков, у каждого потока свое
+ * дерево с переиспользуемым пулом узлов; результаты выводятся в порядке входов
+ * теми же строками, что и в обычном режиме, крупными записями в дескриптор.
+ * Входы, потоки и вывод — общий для всех вариантов BatchRunner, здесь только
+ * преобразование строки через ExpressionTree.
+ */
+class BatchProcessor {
+public:
+    /**
+     * @brief Раскрывает входы в список частей файлов
+     * @param inputs Каталоги, шаблоны или файлы
+     */
+    explicit BatchProcessor(const std::vector<std::string>& inputs);
+
+    /**
+     * @brief Число частей файлов, на которые поделена работа
+     */
+    std::size_t ItemCount() const;
+
+    /**
+     * @brief Обрабатывает все выражения
+     * @param threads Число потоков (0 — по числу ядер)
+     * @param fd Дескриптор вывода
+     * @return Число обработанных выражений
+     */
+    std::size_t Run(unsigned threads = 0, int fd = 1) const;
+
+private:
+    BatchRunner runner;
+};
+
+#endif // BATCHPROCESSOR_H
@@ -0,0 +1,185 @@
+/**
+ * @file BytecodeProgram.cpp
+ * @brief Реализация компилятора дерева в байт-код и интерпретатора
+ */
+
+#include "BytecodeProgram.h"
+#include <algorithm>
+#include <unordered_map>
+#include "ExpressionTree.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Возведение в степень квадрированием по модулю 2^64
+ *
+ * Совпадает с ExpressionTree::ApplyOperation: при показателе <= 0
+ * результат 1, иначе произведение exponent множителей base.
+ */
+long long Power(long long base, long long exponent) {
+    unsigned long long result = 1;
+    unsigned long long factor = static_cast<unsigned long long>(base);
+    for (long long e = exponent; e > 0; e >>= 1) {
+        if (e & 1) result *= factor;
+        factor *= factor;
+    }
+    return static_cast<long long>(result);
+}
+
+} // namespace
+
+BytecodeProgram::BytecodeProgram(const ExpressionTree& tree) {
+    const TreeNode* root = tree.Root();
+    if (!root) {
+        constants.push_back(0);
+        register_count = 1;
+        code.push_back({HALT, 0, 0, 0});
+        return;
+    }
+
+    // Первый проход: различные значения листьев занимают первые регистры
+    unordered_map<long long, uint32_t> constant_ids;
+    vector<const TreeNode*> st{root};
+    while (!st.empty()) {
+        const TreeNode* current = st.back(); st.pop_back();
+        if (current->IsOperation()) {
+            st.push_back(current->right);
+            st.push_back(current->left);
+        } else if (constant_ids.emplace(current->value, static_cast<uint32_t>(constants.size())).second) {
+            constants.push_back(current->value);
+        }
+    }
+    const uint32_t first_temporary = static_cast<uint32_t>(constants.size());
+
+    // Второй проход: обратный обход слева направо, операнды — номера регистров
+    struct Frame {
+        const TreeNode* node;
+        bool expanded;
+    };
+    vector<Frame> frames{{root, false}};
+    vector<uint32_t> operands;
+    vector<uint32_t> free_temporaries;
+    uint32_t temporary_count = 0;
+
+    auto release = [&](uint32_t reg) {
+        if (reg >= first_temporary) free_temporaries.push_back(reg);
+    };
+
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        const TreeNode* current = frame.node;
+
+        if (!current->IsOperation()) {
+            operands.push_back(constant_ids[current->value]);
+            frames.pop_back();
+            continue;
+        }
+        if (!frame.expanded) {
+            frame.expanded = true;
+            frames.push_back({current->right, false});
+            frames.push_back({current->left, false});
+            continue;
+        }
+        frames.pop_back();
+
+        uint32_t right = operands.back(); operands.pop_back();
+        uint32_t left = operands.back(); operands.pop_back();
+        // Операнды читаются до записи, поэтому результат может занять их же регистр
+        release(right);
+        release(left);
+
+        uint32_t target;
+        if (!free_temporaries.empty()) {
+            target = free_temporaries.back();
+            free_temporaries.pop_back();
+        } else {
+            target = first_temporary + temporary_count++;
+        }
+        // Коды операций ADD..POW равны -1..-6, опкоды OP_ADD..OP_POW — 1..6
+        code.push_back({static_cast<uint32_t>(-current->value), target, left, right});
+        operands.push_back(target);
+    }
+
+    code.push_back({HALT, 0, 0, 0});
+    result = operands.back();
+    register_count = first_temporary + temporary_count;
+}
+
+const vector<BytecodeProgram::Instruction>& BytecodeProgram::Code() const {
+    return code;
+}
+
+const vector<long long>& BytecodeProgram::Constants() const {
+    return constants;
+}
+
+size_t BytecodeProgram::ConstantCount() const {
+    return constants.size();
+}
+
+size_t BytecodeProgram::RegisterCount() const {
+    return register_count;
+}
+
+uint32_t BytecodeProgram::ResultRegister() const {
+    return result;
+}
+
+BytecodeVM::BytecodeVM(const BytecodeProgram& program)
+    : program(&program), registers(program.RegisterCount()) {
+    const vector<long long>& constants = program.Constants();
+    copy(constants.begin(), constants.end(), registers.begin());
+}
+
+long long BytecodeVM::Run() {
+    const BytecodeProgram::Instruction* ip = program->Code().data();
+    long long* r = registers.data();
+
+#if defined(__GNUC__)
+    // Шитый код: переход к следующему обработчику из конца текущего, без общего switch
+    static const void* const HANDLERS[] = {
+        &&halt, &&op_add, &&op_sub, &&op_mul, &&op_div, &&op_mod, &&op_pow
+    };
+#define DISPATCH() goto *HANDLERS[ip->opcode]
+#define NEXT() do { ++ip; DISPATCH(); } while (0)
+
+    DISPATCH();
+op_add:
+    r[ip->target] = r[ip->left] + r[ip->right];
+    NEXT();
+op_sub:
+    r[ip->target] = r[ip->left] - r[ip->right];
+    NEXT();
+op_mul:
+    r[ip->target] = r[ip->left] * r[ip->right];
+    NEXT();
+op_div:
+    r[ip->target] = r[ip->left] / r[ip->right];
+    NEXT();
+op_mod:
+    r[ip->target] = r[ip->left] % r[ip->right];
+    NEXT();
+op_pow:
+    r[ip->target] = Power(r[ip->left], r[ip->right]);
+    NEXT();
+halt:
+    return r[program->ResultRegister()];
+
+#undef NEXT
+#undef DISPATCH
+#else
+    for (;; ++ip) {
+        switch (ip->opcode) {
+            case BytecodeProgram::OP_ADD: r[ip->target] = r[ip->left] + r[ip->right]; break;
+            case BytecodeProgram::OP_SUB: r[ip->target] = r[ip->left] - r[ip->right]; break;
+            case BytecodeProgram::OP_MUL: r[ip->target] = r[ip->left] * r[ip->right]; break;
+            case BytecodeProgram::OP_DIV: r[ip->target] = r[ip->left] / r[ip->right]; break;
+            case BytecodeProgram::OP_MOD: r[ip->target] = r[ip->left] % r[ip->right]; break;
+            case BytecodeProgram::OP_POW: r[ip->target] = Power(r[ip->left], r[ip->right]); break;
+            default: return r[program->ResultRegister()];
+        }
+    }
+#endif
+}
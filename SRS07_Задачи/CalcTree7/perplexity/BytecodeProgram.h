@@ -0,0 +1,107 @@
+/**
+ * @file BytecodeProgram.h
+ * @brief Компиляция дерева выражения в регистровый байт-код и его интерпретатор
+ */
+
+#ifndef BYTECODEPROGRAM_H
+#define BYTECODEPROGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ExpressionTree;
+
+/**
+ * @brief Линейная программа вычисления дерева выражения
+ *
+ * Каждая операция дерева — одна инструкция «target = left op right» над
+ * регистрами. Регистры [0, ConstantCount()) хранят различные значения листьев и
+ * не меняются; за ними идут временные регистры, которые переиспользуются, как
+ * только их значение прочитано. Программа заканчивается инструкцией HALT.
+ * Компилировать стоит уже свернутое дерево (после TransformTree).
+ */
+class BytecodeProgram {
+public:
+    enum Opcode : std::uint32_t {
+        HALT,
+        OP_ADD,
+        OP_SUB,
+        OP_MUL,
+        OP_DIV,
+        OP_MOD,
+        OP_POW
+    };
+
+    struct Instruction {
+        std::uint32_t opcode;
+        std::uint32_t target;
+        std::uint32_t left;
+        std::uint32_t right;
+    };
+
+    /**
+     * @brief Компилирует дерево (без рекурсии)
+     * @param tree Дерево выражения; пустое дерево дает программу со значением 0
+     */
+    explicit BytecodeProgram(const ExpressionTree& tree);
+
+    /**
+     * @brief Инструкции, последняя — HALT
+     */
+    const std::vector<Instruction>& Code() const;
+
+    /**
+     * @brief Значения регистров-констант
+     */
+    const std::vector<long long>& Constants() const;
+
+    /**
+     * @brief Число регистров-констант
+     */
+    std::size_t ConstantCount() const;
+
+    /**
+     * @brief Общее число регистров (константы и временные)
+     */
+    std::size_t RegisterCount() const;
+
+    /**
+     * @brief Регистр с результатом после HALT
+     */
+    std::uint32_t ResultRegister() const;
+
+private:
+    std::vector<Instruction> code;
+    std::vector<long long> constants;
+    std::size_t register_count = 0;
+    std::uint32_t result = 0;
+};
+
+/**
+ * @brief Интерпретатор байт-кода с шитым кодом (computed goto в GCC/Clang)
+ *
+ * Хранит собственный файл регистров, поэтому один экземпляр нельзя использовать
+ * из нескольких потоков одновременно; программу можно разделять между ними.
+ * Результаты совпадают с ExpressionTree::Evaluate, включая POW с показателем <= 0.
+ */
+class BytecodeVM {
+public:
+    /**
+     * @brief Готовит регистры для программы
+     * @param program Программа; должна жить дольше интерпретатора
+     */
+    explicit BytecodeVM(const BytecodeProgram& program);
+
+    /**
+     * @brief Выполняет программу
+     * @return Значение выражения
+     */
+    long long Run();
+
+private:
+    const BytecodeProgram* program;
+    std::vector<long long> registers;
+};
+
+#endif // BYTECODEPROGRAM_H
@@ -0,0 +1,198 @@
+/**
+ * @file ColumnarEvaluator.cpp
+ * @brief Реализация векторного вычисления выражения по столбцам
+ */
+
+#include "ColumnarEvaluator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include "ExpressionTree.h"
+
+using namespace std;
+
+namespace {
+
+typedef unsigned long long Word;
+
+// Операции над одной строкой. Арифметика беззнаковая, чтобы переполнение было
+// определено и циклы векторизовались; valid сбрасывается при делении на ноль.
+struct AddLane {
+    static long long Apply(long long a, long long b, uint8_t&) {
+        return static_cast<long long>(static_cast<Word>(a) + static_cast<Word>(b));
+    }
+};
+
+struct SubLane {
+    static long long Apply(long long a, long long b, uint8_t&) {
+        return static_cast<long long>(static_cast<Word>(a) - static_cast<Word>(b));
+    }
+};
+
+struct MulLane {
+    static long long Apply(long long a, long long b, uint8_t&) {
+        return static_cast<long long>(static_cast<Word>(a) * static_cast<Word>(b));
+    }
+};
+
+struct DivLane {
+    static long long Apply(long long a, long long b, uint8_t& valid) {
+        valid &= b != 0;
+        // Делители 0 и -1 подменяются, чтобы не было исключения; -1 дает -a по модулю 2^64
+        long long safe = (b == 0 || b == -1) ? 1 : b;
+        long long quotient = a / safe;
+        if (b == -1) quotient = static_cast<long long>(Word{0} - static_cast<Word>(a));
+        return b == 0 ? 0 : quotient;
+    }
+};
+
+struct ModLane {
+    static long long Apply(long long a, long long b, uint8_t& valid) {
+        valid &= b != 0;
+        long long safe = (b == 0 || b == -1) ? 1 : b;
+        return (b == 0 || b == -1) ? 0 : a % safe;
+    }
+};
+
+struct PowLane {
+    static long long Apply(long long a, long long b, uint8_t&) {
+        // При b <= 0 цикл умножений не выполняется ни разу — результат 1
+        Word result = 1;
+        Word base = static_cast<Word>(a);
+        for (long long e = b; e > 0; e >>= 1) {
+            if (e & 1) result *= base;
+            base *= base;
+        }
+        return static_cast<long long>(result);
+    }
+};
+
+/**
+ * @brief Применяет операцию к блоку строк; нулевой указатель означает константу
+ */
+template <typename Lane>
+void ApplyBlock(const long long* a, long long a_const, const long long* b, long long b_const,
+                long long* target, uint8_t* valid, size_t n) {
+    if (a && b) {
+        for (size_t i = 0; i < n; ++i) target[i] = Lane::Apply(a[i], b[i], valid[i]);
+    } else if (a) {
+        for (size_t i = 0; i < n; ++i) target[i] = Lane::Apply(a[i], b_const, valid[i]);
+    } else if (b) {
+        for (size_t i = 0; i < n; ++i) target[i] = Lane::Apply(a_const, b[i], valid[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) target[i] = Lane::Apply(a_const, b_const, valid[i]);
+    }
+}
+
+} // namespace
+
+ColumnarExpression::ColumnarExpression(const vector<long long>& tokens) {
+    vector<Operand> st;
+    vector<size_t> free_temporaries;
+
+    auto release = [&](const Operand& operand) {
+        if (operand.kind == TEMPORARY) free_temporaries.push_back(static_cast<size_t>(operand.index));
+    };
+
+    // Справа налево, как при построении дерева: листья не занимают временных столбцов
+    for (auto it = tokens.rbegin(); it != tokens.rend(); ++it) {
+        long long code = *it;
+        if (code >= 0) {
+            st.push_back({CONSTANT, code});
+            continue;
+        }
+        if (code <= FIRST_VARIABLE) {
+            long long index = FIRST_VARIABLE - code;
+            variable_count = max(variable_count, static_cast<size_t>(index) + 1);
+            st.push_back({VARIABLE, index});
+            continue;
+        }
+
+        if (st.size() < 2) {
+            cerr << "Некорректное выражение: не хватает операндов" << endl;
+            exit(1);
+        }
+        Operand left = st.back(); st.pop_back();
+        Operand right = st.back(); st.pop_back();
+        release(left);
+        release(right);
+
+        size_t target;
+        if (!free_temporaries.empty()) {
+            target = free_temporaries.back();
+            free_temporaries.pop_back();
+        } else {
+            target = temporary_count++;
+        }
+        steps.push_back({code, left, right, target});
+        st.push_back({TEMPORARY, static_cast<long long>(target)});
+    }
+
+    if (st.size() != 1) {
+        cerr << "Некорректное выражение" << endl;
+        exit(1);
+    }
+    result = st.back();
+}
+
+ColumnarExpression ColumnarExpression::FromFile(const string& file_name) {
+    return ColumnarExpression(ExpressionTree::ReadExpression(file_name, true));
+}
+
+size_t ColumnarExpression::VariableCount() const {
+    return variable_count;
+}
+
+size_t ColumnarExpression::OperationCount() const {
+    return steps.size();
+}
+
+void ColumnarExpression::Evaluate(const ColumnBatch& batch, long long* out, uint8_t* valid) const {
+    if (batch.columns.size() < variable_count) {
+        cerr << "В пакете " << batch.columns.size() << " столбцов, а выражению нужно "
+             << variable_count << endl;
+        exit(1);
+    }
+
+    vector<long long> temporaries(temporary_count * BLOCK_ROWS);
+
+    for (size_t start = 0; start < batch.rows; start += BLOCK_ROWS) {
+        size_t n = min(BLOCK_ROWS, batch.rows - start);
+        uint8_t* block_valid = valid + start;
+        fill(block_valid, block_valid + n, uint8_t{1});
+
+        // Столбец операнда в этом блоке или nullptr для константы
+        auto column = [&](const Operand& operand) -> const long long* {
+            switch (operand.kind) {
+                case VARIABLE: return batch.columns[operand.index] + start;
+                case TEMPORARY: return temporaries.data() + operand.index * BLOCK_ROWS;
+                default: return nullptr;
+            }
+        };
+
+        for (const Step& step : steps) {
+            const long long* a = column(step.left);
+            const long long* b = column(step.right);
+            long long* target = temporaries.data() + step.target * BLOCK_ROWS;
+            long long a_const = step.left.index;
+            long long b_const = step.right.index;
+
+            switch (step.op) {
+                case ADD: ApplyBlock<AddLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                case SUB: ApplyBlock<SubLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                case MUL: ApplyBlock<MulLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                case DIV: ApplyBlock<DivLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                case MOD: ApplyBlock<ModLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                case POW: ApplyBlock<PowLane>(a, a_const, b, b_const, target, block_valid, n); break;
+                default: break;
+            }
+        }
+
+        const long long* value = column(result);
+        if (value) {
+            copy(value, value + n, out + start);
+        } else {
+            fill(out + start, out + start + n, result.index);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ColumnarEvaluator.h
+ * @brief Векторное вычисление выражения с переменными по столбцам пакета строк
+ */
+
+#ifndef COLUMNAREVALUATOR_H
+#define COLUMNAREVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Пакет входных строк в столбцовом виде
+ *
+ * columns[k] указывает на rows значений переменной xk.
+ */
+struct ColumnBatch {
+    std::size_t rows = 0;
+    std::vector<const long long*> columns;
+};
+
+/**
+ * @brief Шаблон выражения, вычисляемый сразу для пакета строк
+ *
+ * Дерево (префиксная форма с переменными x0, x1, ...) один раз переводится в
+ * последовательность шагов над столбцами: операнд — константа, столбец переменной
+ * или временный столбец. Строки обрабатываются блоками; каждый шаг — плотный цикл
+ * по блоку, который компилятор векторизует. Арифметика ведется по модулю 2^64,
+ * POW — возведением в степень квадрированием (тот же результат, что и цикл умножений).
+ * Деление и остаток на ноль не прерывают вычисление: строка помечается недействительной.
+ */
+class ColumnarExpression {
+public:
+    /// Строк в одном блоке вычисления
+    static constexpr std::size_t BLOCK_ROWS = 1024;
+
+    /**
+     * @brief Строит шаги вычисления по токенам
+     * @param tokens Токены в префиксной форме (переменная xk — код FIRST_VARIABLE - k)
+     */
+    explicit ColumnarExpression(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Читает шаблон выражения из файла
+     * @param file_name Имя файла
+     */
+    static ColumnarExpression FromFile(const std::string& file_name);
+
+    /**
+     * @brief Число переменных (наибольший номер + 1)
+     */
+    std::size_t VariableCount() const;
+
+    /**
+     * @brief Число шагов-операций на строку
+     */
+    std::size_t OperationCount() const;
+
+    /**
+     * @brief Вычисляет выражение для всех строк пакета
+     * @param batch Столбцы переменных (не меньше VariableCount())
+     * @param out Результаты, batch.rows значений
+     * @param valid Для каждой строки 1, если не было деления на ноль, иначе 0
+     */
+    void Evaluate(const ColumnBatch& batch, long long* out, std::uint8_t* valid) const;
+
+private:
+    enum OperandKind : std::uint8_t { CONSTANT, VARIABLE, TEMPORARY };
+
+    struct Operand {
+        OperandKind kind;
+        long long index;  // значение константы, номер переменной или временного столбца
+    };
+
+    struct Step {
+        long long op;
+        Operand left;
+        Operand right;
+        std::size_t target;
+    };
+
+    std::vector<Step> steps;
+    Operand result{CONSTANT, 0};
+    std::size_t variable_count = 0;
+    std::size_t temporary_count = 0;
+};
+
+#endif // COLUMNAREVALUATOR_H
@@ -0,0 +1,144 @@
+/**
+ * @file EditableExpressionTree.cpp
+ * @brief Реализация дерева выражения с пересчетом после правки листа
+ */
+
+#include "EditableExpressionTree.h"
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include "ExpressionTree.h"
+
+using namespace std;
+
+namespace {
+
+bool IsOperationCode(long long code) {
+    return code <= -1 && code >= -6;
+}
+
+bool IsFoldedValue(long long value) {
+    return value >= 0 && value <= 9;
+}
+
+void AppendToken(string& out, long long code) {
+    static const char SIGNS[] = {'+', '-', '*', '/', '%', '^'};
+    if (IsOperationCode(code)) {
+        out += SIGNS[-1 - code];
+    } else {
+        char digits[24];
+        out.append(digits, to_chars(digits, digits + sizeof(digits), code).ptr);
+    }
+    out += ' ';
+}
+
+} // namespace
+
+EditableExpressionTree::EditableExpressionTree(const string& file_name)
+    : EditableExpressionTree(ExpressionTree::ReadExpression(file_name)) {}
+
+EditableExpressionTree::EditableExpressionTree(vector<long long> tokens) : codes(move(tokens)) {
+    // Как и ExpressionTree, хранится только первое полное выражение
+    size_t n = ExpressionTree::ExpressionLength(codes);
+    if (n == 0 && !codes.empty()) {
+        cerr << "Некорректное выражение: не хватает операндов" << endl;
+        exit(1);
+    }
+    codes.resize(n);
+    values.resize(n);
+    extents.resize(n);
+    parents.assign(n, uint32_t{NONE});
+
+    // Справа налево: дети операции уже посчитаны и лежат на вершине стека
+    vector<uint32_t> st;
+    st.reserve(n);
+    for (size_t i = n; i-- > 0;) {
+        uint32_t extent = 1;
+        if (IsOperationCode(codes[i])) {
+            uint32_t left = st.back(); st.pop_back();
+            uint32_t right = st.back(); st.pop_back();
+            parents[left] = parents[right] = static_cast<uint32_t>(i);
+            extent += extents[left] + extents[right];
+            extents[i] = extent;
+            values[i] = Recompute(i);
+        } else {
+            extents[i] = extent;
+            values[i] = codes[i];
+        }
+        st.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+long long EditableExpressionTree::Recompute(size_t i) const {
+    long long left_val = values[i + 1];
+    long long right_val = values[i + 1 + extents[i + 1]];
+    if ((codes[i] == DIV || codes[i] == MOD) && right_val == 0) {
+        cerr << "Деление на ноль в узле " << i << endl;
+        exit(1);
+    }
+    return ExpressionTree::ApplyOperation(codes[i], left_val, right_val);
+}
+
+size_t EditableExpressionTree::Size() const {
+    return codes.size();
+}
+
+bool EditableExpressionTree::IsLeaf(size_t i) const {
+    return !IsOperationCode(codes[i]);
+}
+
+long long EditableExpressionTree::Value() const {
+    return values.empty() ? 0 : values[0];
+}
+
+long long EditableExpressionTree::ValueAt(size_t i) const {
+    return values[i];
+}
+
+bool EditableExpressionTree::IsFoldable(size_t i) const {
+    return IsOperationCode(codes[i]) && IsFoldedValue(values[i]);
+}
+
+size_t EditableExpressionTree::SetLeaf(size_t i, long long value) {
+    // Отрицательные коды заняты операциями и переменными, литерал всегда неотрицателен
+    if (i >= codes.size() || !IsLeaf(i) || value < 0) {
+        cerr << "Узел " << i << " не является листом или значение " << value << " отрицательно" << endl;
+        exit(1);
+    }
+    codes[i] = value;
+    if (values[i] == value) return 0;
+    values[i] = value;
+
+    // Выше узла с прежним значением ничего не меняется
+    size_t recomputed = 0;
+    for (uint32_t node = parents[i]; node != NONE; node = parents[node]) {
+        long long result = Recompute(node);
+        ++recomputed;
+        if (result == values[node]) break;
+        values[node] = result;
+    }
+    return recomputed;
+}
+
+void EditableExpressionTree::TransformTree() {
+    folded = true;
+}
+
+void EditableExpressionTree::AppendPrefix(string& out) const {
+    // Сверху вниз: свернутая операция выводится значением, ее поддерево пропускается
+    for (size_t i = 0; i < codes.size();) {
+        if (folded && IsFoldable(i)) {
+            AppendToken(out, values[i]);
+            i += extents[i];
+        } else {
+            AppendToken(out, codes[i]);
+            ++i;
+        }
+    }
+}
+
+void EditableExpressionTree::PrintPrefix() const {
+    string text;
+    AppendPrefix(text);
+    cout << text << endl;
+}
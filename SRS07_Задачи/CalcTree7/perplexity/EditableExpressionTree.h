@@ -0,0 +1,111 @@
+/**
+ * @file EditableExpressionTree.h
+ * @brief Дерево выражения с кэшем значений для быстрого пересчета после правки листа
+ */
+
+#ifndef EDITABLEEXPRESSIONTREE_H
+#define EDITABLEEXPRESSIONTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Плоское дерево в префиксном порядке со значениями всех поддеревьев
+ *
+ * Как и в FlatExpressionTree, узел i — i-й токен префиксной записи, левый
+ * ребенок операции — i + 1, правый — i + 1 + extents[i + 1]. Дополнительно
+ * хранятся родитель каждого узла и значение его поддерева. После замены
+ * листа пересчитываются только узлы на пути к корню, и пересчет
+ * останавливается, как только значение узла не изменилось.
+ *
+ * Структура дерева при правках и свертке не меняется. Свертка "0-9" (как в
+ * TransformTree других представлений) определяется по кэшированным
+ * значениям: операция со значением 0-9 без свернутых предков выводится
+ * листом. Поэтому после правки поддерево само сворачивается заново или
+ * разворачивается, если его значение вышло из диапазона.
+ */
+class EditableExpressionTree {
+private:
+    /// Родитель корня
+    static const std::uint32_t NONE = UINT32_MAX;
+
+    std::vector<long long> codes;
+    std::vector<long long> values;
+    std::vector<std::uint32_t> extents;
+    std::vector<std::uint32_t> parents;
+    bool folded = false;
+
+    /**
+     * @brief Значение операции узла i по кэшированным значениям детей
+     */
+    long long Recompute(std::size_t i) const;
+
+public:
+    /**
+     * @brief Конструктор по файлу с выражением в префиксной форме
+     * @param file_name Имя файла
+     */
+    explicit EditableExpressionTree(const std::string& file_name);
+
+    /**
+     * @brief Конструктор по токенам выражения в префиксной форме
+     * @param tokens Вектор токенов
+     */
+    explicit EditableExpressionTree(std::vector<long long> tokens);
+
+    /**
+     * @brief Количество узлов
+     */
+    std::size_t Size() const;
+
+    /**
+     * @brief Является ли узел листом (только листья можно менять)
+     * @param i Номер узла в префиксном порядке
+     */
+    bool IsLeaf(std::size_t i) const;
+
+    /**
+     * @brief Значение всего выражения
+     */
+    long long Value() const;
+
+    /**
+     * @brief Значение поддерева узла
+     * @param i Номер узла в префиксном порядке
+     */
+    long long ValueAt(std::size_t i) const;
+
+    /**
+     * @brief Сворачивается ли операция правилом "0-9" (без учета предков)
+     * @param i Номер узла в префиксном порядке
+     */
+    bool IsFoldable(std::size_t i) const;
+
+    /**
+     * @brief Заменяет значение листа и пересчитывает путь к корню
+     * @param i Номер листа в префиксном порядке
+     * @param value Новое значение (неотрицательное, как литералы выражения)
+     * @return Число пересчитанных операций
+     */
+    std::size_t SetLeaf(std::size_t i, long long value);
+
+    /**
+     * @brief Включает вывод со сверткой "0-9"; правки после этого по-прежнему допустимы
+     */
+    void TransformTree();
+
+    /**
+     * @brief Дописывает префиксную форму (свернутую после TransformTree) в строку
+     * @param out Строка, к которой добавляются токены, каждый с пробелом после
+     */
+    void AppendPrefix(std::string& out) const;
+
+    /**
+     * @brief Выводит дерево в префиксной форме
+     */
+    void PrintPrefix() const;
+};
+
+#endif // EDITABLEEXPRESSIONTREE_H
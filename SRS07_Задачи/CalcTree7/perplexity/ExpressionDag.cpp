@@ -0,0 +1,168 @@
+/**
+ * @file ExpressionDag.cpp
+ * @brief Реализация дерева выражения с общими поддеревьями
+ */
+
+#include "ExpressionDag.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "ExpressionTree.h"
+#include "TreeEmitter.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+bool IsOperationCode(long long code) {
+    return code <= -1 && code >= -6;
+}
+
+uint64_t Mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+} // namespace
+
+bool ExpressionDag::Node::operator==(const Node& other) const {
+    return value == other.value && left == other.left && right == other.right;
+}
+
+size_t ExpressionDag::NodeHash::operator()(const Node& node) const {
+    uint64_t children = (static_cast<uint64_t>(node.left) << 32) | node.right;
+    return static_cast<size_t>(Mix(static_cast<uint64_t>(node.value) * 0x9e3779b97f4a7c15ULL ^ Mix(children)));
+}
+
+ExpressionDag::ExpressionDag(const string& file_name) {
+    Build(ExpressionTree::ReadExpression(file_name));
+}
+
+ExpressionDag::ExpressionDag(const vector<long long>& tokens) {
+    Build(tokens);
+}
+
+uint32_t ExpressionDag::Intern(long long value, uint32_t left, uint32_t right) {
+    Node node{value, left, right};
+    auto inserted = index.emplace(node, static_cast<uint32_t>(nodes.size()));
+    if (inserted.second) nodes.push_back(node);
+    return inserted.first->second;
+}
+
+void ExpressionDag::Build(const vector<long long>& tokens) {
+    // Как и ExpressionTree, строится только первое полное выражение
+    size_t length = ExpressionTree::ExpressionLength(tokens);
+    if (length == 0 && !tokens.empty()) {
+        cerr << "Некорректное выражение: не хватает операндов" << endl;
+        exit(1);
+    }
+
+    // Справа налево, как в ExpressionTree::BuildTree, но стек хранит номера узлов
+    vector<uint32_t> st;
+    st.reserve(length);
+
+    for (size_t i = length; i-- > 0;) {
+        long long code = tokens[i];
+        if (IsOperationCode(code)) {
+            uint32_t left = st.back(); st.pop_back();
+            uint32_t right = st.back(); st.pop_back();
+            st.push_back(Intern(code, left, right));
+        } else {
+            st.push_back(Intern(code, NONE, NONE));
+        }
+    }
+
+    if (!st.empty()) root = st.back();
+}
+
+vector<long long> ExpressionDag::EvaluateAll() const {
+    vector<long long> values(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const Node& node = nodes[i];
+        values[i] = IsOperationCode(node.value)
+            ? ExpressionTree::ApplyOperation(node.value, values[node.left], values[node.right])
+            : node.value;
+    }
+    return values;
+}
+
+size_t ExpressionDag::UniqueCount() const {
+    return nodes.size();
+}
+
+unsigned long long ExpressionDag::TokenCount() const {
+    if (root == NONE) return 0;
+    vector<unsigned long long> sizes(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const Node& node = nodes[i];
+        sizes[i] = IsOperationCode(node.value) ? 1 + sizes[node.left] + sizes[node.right] : 1;
+    }
+    return sizes[root];
+}
+
+long long ExpressionDag::Evaluate() const {
+    return root == NONE ? 0 : EvaluateAll()[root];
+}
+
+void ExpressionDag::TransformTree() {
+    if (root == NONE) return;
+    vector<long long> values = EvaluateAll();
+
+    auto folds = [&](uint32_t id) {
+        return IsOperationCode(nodes[id].value) && values[id] >= 0 && values[id] <= 9;
+    };
+
+    // Сверху вниз (по убыванию номеров): нужны только узлы, до которых можно
+    // дойти от корня, не проходя через сворачиваемую операцию
+    vector<char> reachable(nodes.size(), 0);
+    reachable[root] = 1;
+    for (size_t i = nodes.size(); i-- > 0;) {
+        if (!reachable[i] || !IsOperationCode(nodes[i].value) || folds(static_cast<uint32_t>(i))) continue;
+        reachable[nodes[i].left] = 1;
+        reachable[nodes[i].right] = 1;
+    }
+
+    // Снизу вверх в новый граф: одинаковые после свертки поддеревья снова сливаются
+    vector<Node> old_nodes;
+    old_nodes.swap(nodes);
+    index.clear();
+    vector<uint32_t> renamed(old_nodes.size(), NONE);
+
+    for (size_t i = 0; i < old_nodes.size(); ++i) {
+        if (!reachable[i]) continue;
+        const Node& node = old_nodes[i];
+        if (!IsOperationCode(node.value)) {
+            renamed[i] = Intern(node.value, NONE, NONE);
+        } else if (values[i] >= 0 && values[i] <= 9) {
+            renamed[i] = Intern(values[i], NONE, NONE);
+        } else {
+            renamed[i] = Intern(node.value, renamed[node.left], renamed[node.right]);
+        }
+    }
+    root = renamed[root];
+}
+
+void ExpressionDag::PrintPrefix() const {
+    // Текст идет в дескриптор мимо cout, поэтому выведенное ранее сбрасывается первым
+    cout.flush();
+    fflush(stdout);
+    TreeEmitter emitter;
+    if (root != NONE) {
+        // Общие узлы раскрываются при каждом обращении, как в обычном дереве
+        vector<uint32_t> st{root};
+        while (!st.empty()) {
+            const Node& node = nodes[st.back()]; st.pop_back();
+            emitter.PutToken(node.value, STDOUT_FILENO);
+            if (IsOperationCode(node.value)) {
+                st.push_back(node.right);
+                st.push_back(node.left);
+            }
+        }
+    }
+    emitter.Flush(STDOUT_FILENO);
+    cout << endl;
+}
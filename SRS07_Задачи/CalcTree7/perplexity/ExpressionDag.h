@@ -0,0 +1,100 @@
+/**
+ * @file ExpressionDag.h
+ * @brief Дерево выражения с общими поддеревьями (hash-consing)
+ */
+
+#ifndef EXPRESSIONDAG_H
+#define EXPRESSIONDAG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Выражение в виде ориентированного ациклического графа
+ *
+ * Структурно одинаковые поддеревья хранятся одним узлом: узел однозначно
+ * задается тройкой (код, номер левого, номер правого ребенка) и ищется в
+ * хеш-таблице перед созданием. Дети всегда имеют меньшие номера, чем родитель,
+ * поэтому значения и свертка считаются одним проходом по узлам, по разу на
+ * каждое различное подвыражение. Вывод раскрывает граф в полную префиксную форму.
+ */
+class ExpressionDag {
+private:
+    /// Номер отсутствующего ребенка у листа
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        long long value;
+        std::uint32_t left;
+        std::uint32_t right;
+
+        bool operator==(const Node& other) const;
+    };
+
+    struct NodeHash {
+        std::size_t operator()(const Node& node) const;
+    };
+
+    std::vector<Node> nodes;
+    std::unordered_map<Node, std::uint32_t, NodeHash> index;
+    std::uint32_t root = NONE;
+
+    /**
+     * @brief Возвращает номер узла, создавая его только если такого еще нет
+     */
+    std::uint32_t Intern(long long value, std::uint32_t left, std::uint32_t right);
+
+    /**
+     * @brief Строит граф по токенам в префиксной форме
+     */
+    void Build(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Значения всех различных подвыражений одним проходом
+     */
+    std::vector<long long> EvaluateAll() const;
+
+public:
+    /**
+     * @brief Конструктор по файлу с выражением в префиксной форме
+     * @param file_name Имя файла
+     */
+    explicit ExpressionDag(const std::string& file_name);
+
+    /**
+     * @brief Конструктор по токенам выражения в префиксной форме
+     * @param tokens Вектор токенов
+     */
+    explicit ExpressionDag(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Число различных подвыражений (узлов графа)
+     */
+    std::size_t UniqueCount() const;
+
+    /**
+     * @brief Число токенов в раскрытой префиксной форме
+     */
+    unsigned long long TokenCount() const;
+
+    /**
+     * @brief Вычисляет значение выражения
+     */
+    long long Evaluate() const;
+
+    /**
+     * @brief Заменяет подвыражения с результатами 0-9 на листья и заново объединяет
+     *        совпавшие после этого поддеревья
+     */
+    void TransformTree();
+
+    /**
+     * @brief Выводит выражение в полной префиксной форме
+     */
+    void PrintPrefix() const;
+};
+
+#endif // EXPRESSIONDAG_H
@@ -4,137 +4,308 @@
  */
 
 #include "ExpressionTree.h"
+#include "TreeEmitter.h"
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <iostream>
-#include <fstream>
-#include <stack>
-#include <cctype>
+
+#include <unistd.h>
 
 using namespace std;
 
-TreeNode::TreeNode(int val) : value(val), left(nullptr), right(nullptr) {}
+namespace {
+
+/**
+ * @brief Собирает узлы поддерева в префиксном порядке с явным стеком
+ *
+ * При проходе списка с конца каждый узел встречается после обоих детей,
+ * а левый ребенок — непосредственно перед родителем на стеке значений.
+ */
+template <typename Node>
+vector<Node*> CollectPreorder(Node* root) {
+    vector<Node*> order;
+    vector<Node*> st{root};
+
+    while (!st.empty()) {
+        Node* node = st.back(); st.pop_back();
+        order.push_back(node);
+        if (node->right) st.push_back(node->right);
+        if (node->left) st.push_back(node->left);
+    }
+
+    return order;
+}
+
+} // namespace
+
+TreeNode::TreeNode(long long val) : value(val), left(nullptr), right(nullptr) {}
 
 bool TreeNode::IsOperation() const {
     return value <= -1 && value >= -6;
 }
 
-shared_ptr<TreeNode> ExpressionTree::CreateNode(int val) const {
-    return make_shared<TreeNode>(val);
+TreeNode* ExpressionTree::CreateNode(long long val) {
+    return arena.Create(val);
 }
 
-int ExpressionTree::EvaluateSubtree(shared_ptr<TreeNode> node) const {
-    if (!node->IsOperation()) {
-        return node->value;
-    }
-
-    int left_val = EvaluateSubtree(node->left);
-    int right_val = EvaluateSubtree(node->right);
-
-    switch (node->value) {
+long long ExpressionTree::ApplyOperation(long long op, long long left_val, long long right_val) {
+    switch (op) {
         case ADD: return left_val + right_val;
         case SUB: return left_val - right_val;
         case MUL: return left_val * right_val;
         case DIV: return left_val / right_val;
         case MOD: return left_val % right_val;
         case POW: {
-            int result = 1;
-            for (int i = 0; i < right_val; ++i) result *= left_val;
-            return result;
+            // Возведение в квадрат по битам показателя; при показателе <= 0 результат 1
+            unsigned long long result = 1;
+            unsigned long long factor = static_cast<unsigned long long>(left_val);
+            for (long long e = right_val; e > 0; e >>= 1) {
+                if (e & 1) result *= factor;
+                factor *= factor;
+            }
+            return static_cast<long long>(result);
         }
         default: return 0;
     }
 }
 
-vector<int> ExpressionTree::ReadExpression(const string& file_name) const {
-    ifstream file(file_name);
-    if (!file) {
-        cerr << "Не удалось открыть файл: " << file_name << endl;
-        exit(1);
-    }
+long long ExpressionTree::EvaluateSubtree(const TreeNode* node) {
+    vector<const TreeNode*> order = CollectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
 
-    vector<int> tokens;
-    char c;
-    while (file >> c) {
-        if (isdigit(static_cast<unsigned char>(c))) {
-            tokens.push_back(c - '0');
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const TreeNode* current = *it;
+        if (current->IsOperation()) {
+            long long left_val = values.back(); values.pop_back();
+            long long right_val = values.back(); values.pop_back();
+            values.push_back(ApplyOperation(current->value, left_val, right_val));
         } else {
-            switch (c) {
-                case '+': tokens.push_back(ADD); break;
-                case '-': tokens.push_back(SUB); break;
-                case '*': tokens.push_back(MUL); break;
-                case '/': tokens.push_back(DIV); break;
-                case '%': tokens.push_back(MOD); break;
-                case '^': tokens.push_back(POW); break;
-                default: break;
-            }
+            values.push_back(current->value);
         }
     }
 
-    return tokens;
+    return values.back();
+}
+
+vector<long long> ExpressionTree::ParseExpression(const char* begin, const char* end, bool allow_variables) {
+    return ExpressionReader::Parse(begin, end, allow_variables);
+}
+
+vector<long long> ExpressionTree::ReadExpression(const string& file_name, bool allow_variables) {
+    return ExpressionReader::Read(file_name, allow_variables);
+}
+
+size_t ExpressionTree::ExpressionLength(const vector<long long>& tokens) {
+    // Число еще не заполненных мест для поддеревьев: операция добавляет одно, лист закрывает
+    size_t open = 1;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (tokens[i] <= ADD && tokens[i] >= POW) {
+            ++open;
+        } else if (--open == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
 }
 
-shared_ptr<TreeNode> ExpressionTree::BuildTree(const vector<int>& tokens) {
-    stack<shared_ptr<TreeNode>> st;
+TreeNode* ExpressionTree::BuildTree(const vector<long long>& tokens) {
+    size_t length = ExpressionLength(tokens);
+    if (length == 0) return nullptr;
+
+    // Узлы и стек построения занимают по одному блоку памяти
+    arena.Reserve(length);
+    vector<TreeNode*> st;
+    st.reserve(length);
 
-    for (auto it = tokens.rbegin(); it != tokens.rend(); ++it) {
-        int val = *it;
-        auto node = CreateNode(val);
+    // Выражение полное, поэтому операндов в стеке всегда хватает
+    for (size_t i = length; i-- > 0;) {
+        TreeNode* node = CreateNode(tokens[i]);
 
         if (node->IsOperation()) {
-            node->left = st.top(); st.pop();
-            node->right = st.top(); st.pop();
+            node->left = st.back(); st.pop_back();
+            node->right = st.back(); st.pop_back();
         }
 
-        st.push(node);
+        st.push_back(node);
     }
 
-    return st.top();
+    return st.back();
+}
+
+const TreeNode* ExpressionTree::Root() const {
+    return root;
+}
+
+long long ExpressionTree::Evaluate() const {
+    return root ? EvaluateSubtree(root) : 0;
+}
+
+long long ExpressionTree::EvaluateParallel(unsigned threads, size_t grain) const {
+    if (!root) return 0;
+    WorkStealingScheduler scheduler(threads);
+    long long result = 0;
+    scheduler.Run([&] { result = ReduceParallel(scheduler, root, max<size_t>(grain, 1), false); });
+    return result;
 }
 
 void ExpressionTree::TransformTree() {
-    TransformTree(root);
+    if (root) FoldSubtree(root);
 }
 
-void ExpressionTree::TransformTree(shared_ptr<TreeNode> node) {
-    if (!node) return;
+void ExpressionTree::TransformTreeParallel(unsigned threads, size_t grain) {
+    if (!root) return;
+    WorkStealingScheduler scheduler(threads);
+    scheduler.Run([&] { ReduceParallel(scheduler, root, max<size_t>(grain, 1), true); });
+}
+
+long long ExpressionTree::ReduceParallel(WorkStealingScheduler& scheduler, TreeNode* node,
+                                         size_t grain, bool fold) {
+    // Ожидание выполняет чужие задачи на том же стеке вызовов; глубже предела — без задач
+    static thread_local size_t nesting = 0;
+    if (nesting >= MAX_NESTING) return fold ? FoldSubtree(node) : EvaluateSubtree(node);
+    ++nesting;
+
+    /// Окно обхода: посещенные узлы и непосещенные поддеревья в порядке стека
+    struct Window {
+        vector<TreeNode*> order;
+        vector<TreeNode*> pending;
+        vector<long long> values;
+        size_t continued = SIZE_MAX;
+        WorkStealingScheduler::Group group;
+    };
+
+    // deque не перемещает окна: порожденные задачи пишут прямо в их values
+    deque<Window> windows;
+    for (TreeNode* next = node; next;) {
+        Window& window = windows.emplace_back();
+        vector<TreeNode*>& st = window.pending;
+        st.push_back(next);
+        while (!st.empty() && window.order.size() < grain) {
+            TreeNode* current = st.back(); st.pop_back();
+            window.order.push_back(current);
+            if (current->IsOperation()) {
+                st.push_back(current->right);
+                st.push_back(current->left);
+            }
+        }
+
+        // Вершина стека — следующее поддерево в прямом порядке, дно — последнее;
+        // деление на окна и задачи не зависит от числа потоков
+        next = nullptr;
+        window.values.resize(st.size());
+        for (size_t i = 0; i < st.size(); ++i) {
+            if (!st[i]->IsOperation()) {
+                window.values[i] = st[i]->value;
+            } else if (!next) {
+                next = st[i];
+                window.continued = i;
+            } else {
+                long long& value = window.values[i];
+                TreeNode* subtree = st[i];
+                scheduler.Spawn(window.group, [&scheduler, &value, subtree, grain, fold] {
+                    value = ReduceParallel(scheduler, subtree, grain, fold);
+                });
+            }
+        }
+    }
+
+    // Окна досчитываются с самого глубокого; его результат — значение продолженного поддерева
+    long long result = 0;
+    for (auto window = windows.rbegin(); window != windows.rend(); ++window) {
+        vector<long long>& values = window->values;
+        if (window->continued != SIZE_MAX) values[window->continued] = result;
+        scheduler.Wait(window->group);
+
+        // Значения отложенных поддеревьев уже лежат на стеке в порядке обратного обхода
+        values.reserve(values.size() + window->order.size());
+        for (auto it = window->order.rbegin(); it != window->order.rend(); ++it) {
+            TreeNode* current = *it;
+            if (!current->IsOperation()) {
+                values.push_back(current->value);
+                continue;
+            }
 
-    TransformTree(node->left);
-    TransformTree(node->right);
+            long long left_val = values.back(); values.pop_back();
+            long long right_val = values.back(); values.pop_back();
+            long long value = ApplyOperation(current->value, left_val, right_val);
+
+            if (fold && value >= 0 && value <= 9) {
+                current->value = value;
+                current->left = nullptr;
+                current->right = nullptr;
+            }
+            values.push_back(value);
+        }
+        result = values.back();
+    }
+
+    --nesting;
+    return result;
+}
+
+long long ExpressionTree::FoldSubtree(TreeNode* node) {
+    vector<TreeNode*> order = CollectPreorder(node);
+    vector<long long> values;
+    values.reserve(order.size());
+
+    // Родитель получает значения детей со стека, а не вычисляет поддерево заново
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        TreeNode* current = *it;
+        if (!current->IsOperation()) {
+            values.push_back(current->value);
+            continue;
+        }
+
+        long long left_val = values.back(); values.pop_back();
+        long long right_val = values.back(); values.pop_back();
+        long long result = ApplyOperation(current->value, left_val, right_val);
 
-    if (node->IsOperation()) {
-        int result = EvaluateSubtree(node);
         if (result >= 0 && result <= 9) {
-            node->value = result;
-            node->left = nullptr;
-            node->right = nullptr;
+            current->value = result;
+            current->left = nullptr;
+            current->right = nullptr;
         }
+        values.push_back(result);
     }
+
+    return values.back();
 }
 
 void ExpressionTree::PrintPrefix() const {
-    PrintPrefix(root);
+    // Текст идет в дескриптор мимо cout, поэтому выведенное ранее сбрасывается первым
+    cout.flush();
+    fflush(stdout);
+    TreeEmitter emitter;
+    emitter.Write(root, TreeEmitter::PREFIX, STDOUT_FILENO);
     cout << endl;
 }
 
-void ExpressionTree::PrintPrefix(shared_ptr<TreeNode> node) const {
-    if (!node) return;
+void ExpressionTree::AppendPrefix(string& out) const {
+    AppendPrefix(root, out);
+}
 
-    if (node->IsOperation()) {
-        switch (node->value) {
-            case ADD: cout << "+ "; break;
-            case SUB: cout << "- "; break;
-            case MUL: cout << "* "; break;
-            case DIV: cout << "/ "; break;
-            case MOD: cout << "% "; break;
-            case POW: cout << "^ "; break;
-        }
-    } else {
-        cout << node->value << " ";
-    }
+void ExpressionTree::AppendPrefix(const TreeNode* node, string& out) {
+    size_t old_size = out.size();
+    out.resize(old_size + TreeEmitter::Length(node, TreeEmitter::PREFIX));
+    TreeEmitter::Write(node, TreeEmitter::PREFIX, &out[old_size]);
+}
 
-    PrintPrefix(node->left);
-    PrintPrefix(node->right);
+ExpressionTree::ExpressionTree(const string& file_name) : ExpressionTree(ReadExpression(file_name)) {}
+
+ExpressionTree::ExpressionTree(const vector<long long>& tokens) {
+    if (!Assign(tokens)) {
+        cerr << "Некорректное выражение: не хватает операндов" << endl;
+        exit(1);
+    }
 }
 
-ExpressionTree::ExpressionTree(const string& file_name) {
-    root = BuildTree(ReadExpression(file_name));
+bool ExpressionTree::Assign(const vector<long long>& tokens) {
+    arena.Clear();
+    root = tokens.empty() ? nullptr : BuildTree(tokens);
+    return tokens.empty() || root;
 }
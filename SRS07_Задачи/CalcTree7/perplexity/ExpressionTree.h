@@ -6,9 +6,13 @@
 #ifndef EXPRESSIONTREE_H
 #define EXPRESSIONTREE_H
 
-#include <memory>
+#include <cstddef>
 #include <string>
 #include <vector>
+#include "../common/ExpressionReader.h"
+#include "../common/NodeArena.h"
+
+class WorkStealingScheduler;
 
 enum Operation {
     ADD = -1,
@@ -21,18 +25,20 @@ enum Operation {
 
 /**
  * @brief Узел дерева выражения
+ *
+ * Узлы хранятся в пуле NodeArena, дети связаны обычными указателями.
  */
 class TreeNode {
 public:
-    int value;
-    std::shared_ptr<TreeNode> left;
-    std::shared_ptr<TreeNode> right;
+    long long value;
+    TreeNode* left;
+    TreeNode* right;
 
     /**
      * @brief Конструктор узла дерева
      * @param val Значение узла
      */
-    explicit TreeNode(int val);
+    explicit TreeNode(long long val);
 
     /**
      * @brief Проверяет, является ли узел операцией
@@ -41,69 +47,181 @@ public:
     bool IsOperation() const;
 };
 
+/// Пул узлов дерева (общий для вариантов, см. common/NodeArena.h)
+using NodeArena = BasicNodeArena<TreeNode>;
+
 /**
  * @brief Класс для работы с деревом выражений
  */
 class ExpressionTree {
 private:
-    std::shared_ptr<TreeNode> root;
+    NodeArena arena;
+    TreeNode* root = nullptr;
 
     /**
      * @brief Создает новый узел дерева
      * @param val Значение узла
      * @return Указатель на созданный узел
      */
-    std::shared_ptr<TreeNode> CreateNode(int val) const;
+    TreeNode* CreateNode(long long val);
 
     /**
-     * @brief Вычисляет значение поддерева
+     * @brief Вычисляет значение поддерева без рекурсии
      * @param node Корень поддерева
      * @return Значение поддерева
      */
-    int EvaluateSubtree(std::shared_ptr<TreeNode> node) const;
+    static long long EvaluateSubtree(const TreeNode* node);
+
+    /**
+     * @brief Свертка поддерева за один проход снизу вверх (без рекурсии)
+     * @param node Корень поддерева
+     * @return Значение поддерева (вычисляется для каждого узла один раз)
+     */
+    static long long FoldSubtree(TreeNode* node);
 
     /**
-     * @brief Рекурсивная функция преобразования дерева
-     * @param node Текущий узел
+     * @brief Дописывает префиксную форму поддерева в строку (явный стек вместо рекурсии)
+     * @param node Корень поддерева
+     * @param out Строка, к которой добавляются токены, каждый с пробелом после
      */
-    void TransformTree(std::shared_ptr<TreeNode> node);
+    static void AppendPrefix(const TreeNode* node, std::string& out);
 
     /**
-     * @brief Рекурсивная функция вывода дерева
-     * @param node Текущий узел
+     * @brief Вычисляет или сворачивает поддерево задачами планировщика
+     *
+     * Поддерево обходится в прямом порядке окнами не больше grain узлов. Из
+     * непосещенных поддеревьев-операции окна последнее продолжается в той же
+     * задаче следующим окном, остальные порождаются отдельными задачами; окна
+     * хранятся в куче, а досчитываются в обратном порядке после ожидания. Так
+     * глубина стека вызовов не растет с высотой дерева; при слишком глубокой
+     * вложенности задач (MAX_NESTING) поддерево сворачивается последовательно.
+     * @param scheduler Планировщик, внутри Run которого идет вызов
+     * @param node Корень поддерева
+     * @param grain Наибольшее число узлов, обходимых одной задачей
+     * @param fold Сворачивать ли операции с результатами 0-9 в листья
+     * @return Значение поддерева
      */
-    void PrintPrefix(std::shared_ptr<TreeNode> node) const;
+    static long long ReduceParallel(WorkStealingScheduler& scheduler, TreeNode* node, std::size_t grain, bool fold);
+
+    /// Наибольшая вложенность ReduceParallel в одном потоке (задачи, выполняемые при ожидании)
+    static constexpr std::size_t MAX_NESTING = 64;
 
 public:
+    /// Узлов, обрабатываемых одной задачей без дальнейшего деления
+    static constexpr std::size_t PARALLEL_GRAIN = std::size_t{1} << 15;
+
     /**
      * @brief Конструктор ExpressionTree
      * @param file_name Имя файла с выражением
      */
     explicit ExpressionTree(const std::string& file_name);
 
+    /**
+     * @brief Пустое дерево, которое затем заполняется через Assign
+     */
+    ExpressionTree() = default;
+
+    /**
+     * @brief Конструктор по токенам выражения в префиксной форме
+     * @param tokens Вектор токенов
+     */
+    explicit ExpressionTree(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Строит новое дерево на месте прежнего, переиспользуя память пула
+     * @param tokens Вектор токенов (пустой — пустое дерево)
+     * @return false, если операции не хватает операндов (дерево остается пустым)
+     */
+    bool Assign(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Применяет операцию к значениям операндов
+     * @param op Код операции
+     * @param left_val Значение левого операнда
+     * @param right_val Значение правого операнда
+     * @return Результат операции
+     */
+    static long long ApplyOperation(long long op, long long left_val, long long right_val);
+
     /**
      * @brief Читает выражение из файла
+     *
+     * Файл отображается в память и разбирается за один проход по таблице классов
+     * байтов; операнды — неотрицательные целые любой длины в пределах long long.
      * @param file_name Имя файла
+     * @param allow_variables Разбирать ли переменные вида x0, x1, ... (иначе 'x' игнорируется)
      * @return Вектор токенов выражения
      */
-    std::vector<int> ReadExpression(const std::string& file_name) const;
+    static std::vector<long long> ReadExpression(const std::string& file_name, bool allow_variables = false);
+
+    /**
+     * @brief Разбирает выражение из буфера в памяти
+     * @param begin Начало текста
+     * @param end Конец текста
+     * @param allow_variables Разбирать ли переменные вида x0, x1, ...
+     * @return Вектор токенов выражения
+     */
+    static std::vector<long long> ParseExpression(const char* begin, const char* end, bool allow_variables = false);
+
+    /**
+     * @brief Длина первого полного выражения в префиксной записи
+     *
+     * Все представления дерева строятся только по этим токенам, остальные
+     * игнорируются.
+     * @param tokens Вектор токенов
+     * @return Число токенов выражения; 0, если операциям не хватает операндов
+     */
+    static std::size_t ExpressionLength(const std::vector<long long>& tokens);
 
     /**
      * @brief Строит дерево выражения из префиксной формы
+     *
+     * Токены после первого полного выражения не используются.
      * @param tokens Вектор токенов
-     * @return Указатель на корень дерева
+     * @return Указатель на корень дерева (узлы принадлежат этому объекту);
+     *         nullptr, если токенов нет или операции не хватает операндов
+     */
+    TreeNode* BuildTree(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Корень дерева (nullptr, если дерево не построено)
      */
-    std::shared_ptr<TreeNode> BuildTree(const std::vector<int>& tokens);
+    const TreeNode* Root() const;
+
+    /**
+     * @brief Вычисляет значение всего выражения обходом дерева
+     */
+    long long Evaluate() const;
+
+    /**
+     * @brief Вычисляет выражение параллельно; результат тот же, что у Evaluate
+     * @param threads Число потоков (0 — по числу ядер)
+     * @param grain Поддеревья не больше grain узлов считаются последовательно
+     */
+    long long EvaluateParallel(unsigned threads = 0, std::size_t grain = PARALLEL_GRAIN) const;
 
     /**
      * @brief Преобразует дерево, заменяя поддеревья с результатами 0-9 на листья
      */
     void TransformTree();
 
+    /**
+     * @brief Параллельная свертка; дерево получается тем же, что у TransformTree
+     * @param threads Число потоков (0 — по числу ядер)
+     * @param grain Поддеревья не больше grain узлов сворачиваются последовательно
+     */
+    void TransformTreeParallel(unsigned threads = 0, std::size_t grain = PARALLEL_GRAIN);
+
     /**
      * @brief Выводит дерево в префиксной форме
      */
     void PrintPrefix() const;
+
+    /**
+     * @brief Дописывает префиксную форму дерева в строку (без перевода строки)
+     * @param out Строка-приемник
+     */
+    void AppendPrefix(std::string& out) const;
 };
 
 #endif // EXPRESSIONTREE_H
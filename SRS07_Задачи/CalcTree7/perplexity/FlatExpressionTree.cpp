@@ -0,0 +1,121 @@
+/**
+ * @file FlatExpressionTree.cpp
+ * @brief Реализация плоского представления дерева выражения
+ */
+
+#include "FlatExpressionTree.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "ExpressionTree.h"
+#include "TreeEmitter.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+bool IsOperationCode(long long code) {
+    return code <= -1 && code >= -6;
+}
+
+} // namespace
+
+FlatExpressionTree::FlatExpressionTree(const string& file_name)
+    : FlatExpressionTree(ExpressionTree::ReadExpression(file_name)) {}
+
+FlatExpressionTree::FlatExpressionTree(vector<long long> tokens) : codes(move(tokens)) {
+    // Как и ExpressionTree, хранится только первое полное выражение
+    size_t length = ExpressionTree::ExpressionLength(codes);
+    if (length == 0 && !codes.empty()) {
+        cerr << "Некорректное выражение: не хватает операндов" << endl;
+        exit(1);
+    }
+    codes.resize(length);
+    ComputeExtents();
+}
+
+void FlatExpressionTree::ComputeExtents() {
+    // Справа налево: размеры поддеревьев детей операции лежат на вершине стека
+    extents.resize(codes.size());
+    vector<uint32_t> st;
+    st.reserve(codes.size());
+
+    for (size_t i = codes.size(); i-- > 0;) {
+        uint32_t extent = 1;
+        if (IsOperationCode(codes[i])) {
+            extent += st.back(); st.pop_back();
+            extent += st.back(); st.pop_back();
+        }
+        extents[i] = extent;
+        st.push_back(extent);
+    }
+}
+
+vector<long long> FlatExpressionTree::EvaluateAll() const {
+    vector<long long> values(codes.size());
+    for (size_t i = codes.size(); i-- > 0;) {
+        if (IsOperationCode(codes[i])) {
+            values[i] = ExpressionTree::ApplyOperation(codes[i], values[i + 1], values[i + 1 + extents[i + 1]]);
+        } else {
+            values[i] = codes[i];
+        }
+    }
+    return values;
+}
+
+size_t FlatExpressionTree::Size() const {
+    return codes.size();
+}
+
+const vector<long long>& FlatExpressionTree::Codes() const {
+    return codes;
+}
+
+uint32_t FlatExpressionTree::Extent(size_t i) const {
+    return extents[i];
+}
+
+long long FlatExpressionTree::Evaluate() const {
+    // Стек значений вместо массива на каждый узел: левый операнд всегда снят последним
+    vector<long long> st;
+    for (size_t i = codes.size(); i-- > 0;) {
+        if (IsOperationCode(codes[i])) {
+            long long left_val = st.back(); st.pop_back();
+            long long right_val = st.back(); st.pop_back();
+            st.push_back(ExpressionTree::ApplyOperation(codes[i], left_val, right_val));
+        } else {
+            st.push_back(codes[i]);
+        }
+    }
+    return st.back();
+}
+
+void FlatExpressionTree::TransformTree() {
+    vector<long long> values = EvaluateAll();
+
+    // Сверху вниз: самая верхняя сворачиваемая операция становится листом,
+    // ее поддерево пропускается целиком; запись идет не правее чтения
+    size_t write = 0;
+    for (size_t read = 0; read < codes.size();) {
+        if (IsOperationCode(codes[read]) && values[read] >= 0 && values[read] <= 9) {
+            codes[write++] = values[read];
+            read += extents[read];
+        } else {
+            codes[write++] = codes[read++];
+        }
+    }
+    codes.resize(write);
+    ComputeExtents();
+}
+
+void FlatExpressionTree::PrintPrefix() const {
+    // Текст идет в дескриптор мимо cout, поэтому выведенное ранее сбрасывается первым
+    cout.flush();
+    fflush(stdout);
+    TreeEmitter emitter;
+    for (long long code : codes) emitter.PutToken(code, STDOUT_FILENO);
+    emitter.Flush(STDOUT_FILENO);
+    cout << endl;
+}
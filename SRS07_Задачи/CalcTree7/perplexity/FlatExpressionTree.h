@@ -0,0 +1,82 @@
+/**
+ * @file FlatExpressionTree.h
+ * @brief Дерево выражения в виде плоского массива в префиксном порядке
+ */
+
+#ifndef FLATEXPRESSIONTREE_H
+#define FLATEXPRESSIONTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Дерево выражения без указателей: токены в префиксном порядке и размеры поддеревьев
+ *
+ * Узел i хранит код (значение или операцию, как в TreeNode) и число узлов своего
+ * поддерева extents[i]. Левый ребенок операции — элемент i + 1, правый —
+ * i + 1 + extents[i + 1]. Вычисление, свертка и вывод — линейные проходы по массивам.
+ */
+class FlatExpressionTree {
+private:
+    std::vector<long long> codes;
+    std::vector<std::uint32_t> extents;
+
+    /**
+     * @brief Пересчитывает размеры поддеревьев по массиву кодов
+     */
+    void ComputeExtents();
+
+    /**
+     * @brief Вычисляет значения всех поддеревьев одним проходом справа налево
+     * @return Значение поддерева с корнем в каждом узле
+     */
+    std::vector<long long> EvaluateAll() const;
+
+public:
+    /**
+     * @brief Конструктор по файлу с выражением в префиксной форме
+     * @param file_name Имя файла
+     */
+    explicit FlatExpressionTree(const std::string& file_name);
+
+    /**
+     * @brief Конструктор по токенам выражения в префиксной форме
+     * @param tokens Вектор токенов
+     */
+    explicit FlatExpressionTree(std::vector<long long> tokens);
+
+    /**
+     * @brief Количество узлов
+     */
+    std::size_t Size() const;
+
+    /**
+     * @brief Коды узлов в префиксном порядке
+     */
+    const std::vector<long long>& Codes() const;
+
+    /**
+     * @brief Размер поддерева узла
+     * @param i Номер узла в префиксном порядке
+     */
+    std::uint32_t Extent(std::size_t i) const;
+
+    /**
+     * @brief Вычисляет значение выражения
+     */
+    long long Evaluate() const;
+
+    /**
+     * @brief Заменяет поддеревья с результатами 0-9 на листья, сжимая массивы на месте
+     */
+    void TransformTree();
+
+    /**
+     * @brief Выводит дерево в префиксной форме
+     */
+    void PrintPrefix() const;
+};
+
+#endif // FLATEXPRESSIONTREE_H
@@ -0,0 +1,259 @@
+/**
+ * @file JitExpression.cpp
+ * @brief Реализация генератора машинного кода x86-64 для выражения
+ */
+
+#include "JitExpression.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__))
+#define CALCTREE_JIT 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+#ifdef CALCTREE_JIT
+
+/// Наибольший стековый кадр для временных регистров (с запасом для стеков потоков)
+const size_t MAX_FRAME_BYTES = size_t{1} << 18;
+
+/**
+ * @brief Запись машинных команд x86-64 в буфер
+ *
+ * Используются только rax (левый операнд и результат), rcx (правый операнд),
+ * rdx (остаток и результат POW) и rdi (указатель на флаг деления на ноль).
+ */
+class X64Emitter {
+public:
+    enum Register : uint8_t { RAX = 0, RCX = 1 };
+
+    vector<uint8_t> bytes;
+
+    void Emit(initializer_list<uint8_t> code) {
+        bytes.insert(bytes.end(), code);
+    }
+
+    void Emit32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void Emit64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    /// mov reg, imm (знаковое 32-битное, если помещается)
+    void LoadConstant(Register reg, long long value) {
+        if (value >= INT32_MIN && value <= INT32_MAX) {
+            Emit({0x48, 0xC7, static_cast<uint8_t>(0xC0 | reg)});
+            Emit32(static_cast<uint32_t>(value));
+        } else {
+            Emit({0x48, static_cast<uint8_t>(0xB8 | reg)});
+            Emit64(static_cast<uint64_t>(value));
+        }
+    }
+
+    /// mov reg, [rsp + offset]
+    void LoadSlot(Register reg, uint32_t offset) {
+        Emit({0x48, 0x8B, static_cast<uint8_t>(0x84 | (reg << 3)), 0x24});
+        Emit32(offset);
+    }
+
+    /// mov [rsp + offset], rax
+    void StoreSlot(uint32_t offset) {
+        Emit({0x48, 0x89, 0x84, 0x24});
+        Emit32(offset);
+    }
+
+    /// jz к метке деления на ноль; возвращает место смещения для последующей правки
+    size_t JumpIfZeroPlaceholder() {
+        Emit({0x0F, 0x84});
+        size_t at = bytes.size();
+        Emit32(0);
+        return at;
+    }
+
+    void PatchRel32(size_t at, size_t destination) {
+        uint32_t rel = static_cast<uint32_t>(destination - (at + 4));
+        memcpy(bytes.data() + at, &rel, 4);
+    }
+};
+
+/**
+ * @brief Переводит программу в машинный код
+ * @return false, если кадр временных регистров слишком велик
+ */
+bool Generate(const BytecodeProgram& program, X64Emitter& out) {
+    const vector<BytecodeProgram::Instruction>& code = program.Code();
+    const vector<long long>& constants = program.Constants();
+    const uint32_t first_temporary = static_cast<uint32_t>(program.ConstantCount());
+
+    size_t frame = (program.RegisterCount() - first_temporary) * 8;
+    if (frame > MAX_FRAME_BYTES) return false;
+    const uint32_t frame32 = static_cast<uint32_t>(frame);
+
+    auto load = [&](X64Emitter::Register reg, uint32_t operand) {
+        if (operand < first_temporary) {
+            out.LoadConstant(reg, constants[operand]);
+        } else {
+            out.LoadSlot(reg, (operand - first_temporary) * 8);
+        }
+    };
+    auto epilogue = [&] {
+        if (frame32) {
+            out.Emit({0x48, 0x81, 0xC4});  // add rsp, frame
+            out.Emit32(frame32);
+        }
+        out.Emit({0xC3});  // ret
+    };
+
+    out.Emit({0xC7, 0x07});  // mov dword [rdi], 0
+    out.Emit32(0);
+    if (frame32) {
+        out.Emit({0x48, 0x81, 0xEC});  // sub rsp, frame
+        out.Emit32(frame32);
+    }
+
+    vector<size_t> zero_jumps;
+    // Регистр байт-кода, значение которого сейчас в rax (результат предыдущей операции)
+    const uint32_t NONE = UINT32_MAX;
+    uint32_t cached = NONE;
+
+    for (size_t i = 0; code[i].opcode != BytecodeProgram::HALT; ++i) {
+        const BytecodeProgram::Instruction& instruction = code[i];
+
+        // Правый операнд грузится первым: он может быть в rax от прошлой операции
+        if (instruction.right == cached) {
+            out.Emit({0x48, 0x89, 0xC1});  // mov rcx, rax
+        } else {
+            load(X64Emitter::RCX, instruction.right);
+        }
+        if (instruction.left != cached) load(X64Emitter::RAX, instruction.left);
+
+        switch (instruction.opcode) {
+            case BytecodeProgram::OP_ADD:
+                out.Emit({0x48, 0x01, 0xC8});  // add rax, rcx
+                break;
+            case BytecodeProgram::OP_SUB:
+                out.Emit({0x48, 0x29, 0xC8});  // sub rax, rcx
+                break;
+            case BytecodeProgram::OP_MUL:
+                out.Emit({0x48, 0x0F, 0xAF, 0xC1});  // imul rax, rcx
+                break;
+            case BytecodeProgram::OP_DIV:
+            case BytecodeProgram::OP_MOD: {
+                bool mod = instruction.opcode == BytecodeProgram::OP_MOD;
+                out.Emit({0x48, 0x85, 0xC9});  // test rcx, rcx
+                zero_jumps.push_back(out.JumpIfZeroPlaceholder());
+                // Делитель -1 обрабатывается отдельно: idiv LLONG_MIN / -1 дает исключение
+                out.Emit({0x48, 0x83, 0xF9, 0xFF});  // cmp rcx, -1
+                if (mod) {
+                    out.Emit({0x75, 0x04, 0x31, 0xC0, 0xEB, 0x08});  // jne; xor eax, eax; jmp
+                    out.Emit({0x48, 0x99, 0x48, 0xF7, 0xF9});        // cqo; idiv rcx
+                    out.Emit({0x48, 0x89, 0xD0});                    // mov rax, rdx
+                } else {
+                    out.Emit({0x75, 0x05, 0x48, 0xF7, 0xD8, 0xEB, 0x05});  // jne; neg rax; jmp
+                    out.Emit({0x48, 0x99, 0x48, 0xF7, 0xF9});              // cqo; idiv rcx
+                }
+                break;
+            }
+            case BytecodeProgram::OP_POW:
+                // rdx = 1; при rcx > 0: пока rcx, умножать rdx на rax для единичных битов
+                out.Emit({0xBA, 0x01, 0x00, 0x00, 0x00});  // mov edx, 1
+                out.Emit({0x48, 0x85, 0xC9, 0x7E, 0x12});  // test rcx, rcx; jle done
+                out.Emit({0xF6, 0xC1, 0x01, 0x74, 0x04});  // test cl, 1; jz skip
+                out.Emit({0x48, 0x0F, 0xAF, 0xD0});        // imul rdx, rax
+                out.Emit({0x48, 0x0F, 0xAF, 0xC0});        // skip: imul rax, rax
+                out.Emit({0x48, 0xD1, 0xF9, 0x75, 0xEE});  // sar rcx, 1; jnz loop
+                out.Emit({0x48, 0x89, 0xD0});              // done: mov rax, rdx
+                break;
+            default:
+                break;
+        }
+
+        // Каждое временное значение читается ровно один раз: если его берет
+        // следующая операция или это результат, в кадр его можно не сохранять
+        const BytecodeProgram::Instruction& next = code[i + 1];
+        bool consumed_next = next.opcode == BytecodeProgram::HALT ||
+                             next.left == instruction.target || next.right == instruction.target;
+        if (!consumed_next) out.StoreSlot((instruction.target - first_temporary) * 8);
+        cached = instruction.target;
+    }
+
+    if (program.ResultRegister() != cached) load(X64Emitter::RAX, program.ResultRegister());
+    epilogue();
+
+    size_t zero_label = out.bytes.size();
+    for (size_t at : zero_jumps) out.PatchRel32(at, zero_label);
+    out.Emit({0xC7, 0x07});  // mov dword [rdi], 1
+    out.Emit32(1);
+    out.Emit({0x31, 0xC0});  // xor eax, eax
+    epilogue();
+    return true;
+}
+
+#endif // CALCTREE_JIT
+
+} // namespace
+
+JitExpression::JitExpression(const BytecodeProgram& program) : vm(program) {
+#ifdef CALCTREE_JIT
+    X64Emitter emitter;
+    if (!Generate(program, emitter)) return;
+
+    size_t system_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t size = (emitter.bytes.size() + system_page - 1) / system_page * system_page;
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return;
+
+    // Страница не бывает одновременно записываемой и исполняемой
+    memcpy(memory, emitter.bytes.data(), emitter.bytes.size());
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return;
+    }
+
+    page = memory;
+    page_size = size;
+    code_size = emitter.bytes.size();
+    function = reinterpret_cast<Function>(memory);
+#endif
+}
+
+JitExpression::~JitExpression() {
+#ifdef CALCTREE_JIT
+    if (page) munmap(page, page_size);
+#endif
+}
+
+bool JitExpression::IsNative() const {
+    return function != nullptr;
+}
+
+JitExpression::Function JitExpression::NativeFunction() const {
+    return function;
+}
+
+size_t JitExpression::CodeSize() const {
+    return code_size;
+}
+
+long long JitExpression::Evaluate() {
+    if (!function) return vm.Run();
+
+    int division_by_zero = 0;
+    long long value = function(&division_by_zero);
+    if (division_by_zero) {
+        cerr << "Деление на ноль при вычислении выражения" << endl;
+        exit(1);
+    }
+    return value;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file JitExpression.h
+ * @brief Компиляция байт-кода выражения в машинный код x86-64
+ */
+
+#ifndef JITEXPRESSION_H
+#define JITEXPRESSION_H
+
+#include <cstddef>
+#include "BytecodeProgram.h"
+
+/**
+ * @brief Выражение, скомпилированное в машинный код
+ *
+ * На x86-64 (System V) каждая инструкция байт-кода превращается в несколько
+ * машинных команд: константы — непосредственные операнды, временные регистры —
+ * ячейки стекового кадра, результат предыдущей операции остается в rax.
+ * Код размещается в отдельной странице, доступной на выполнение только после
+ * записи. Деление и остаток на ноль не вызывают исключения: функция возвращает 0
+ * и записывает 1 в *division_by_zero. POW — возведение в степень квадрированием.
+ * На других архитектурах, при слишком большом кадре или отказе mmap используется
+ * интерпретатор BytecodeVM.
+ */
+class JitExpression {
+public:
+    typedef long long (*Function)(int* division_by_zero);
+
+    /**
+     * @brief Компилирует программу
+     * @param program Программа; должна жить дольше объекта
+     */
+    explicit JitExpression(const BytecodeProgram& program);
+
+    ~JitExpression();
+
+    JitExpression(const JitExpression&) = delete;
+    JitExpression& operator=(const JitExpression&) = delete;
+
+    /**
+     * @brief Удалось ли получить машинный код
+     */
+    bool IsNative() const;
+
+    /**
+     * @brief Указатель на скомпилированную функцию или nullptr
+     */
+    Function NativeFunction() const;
+
+    /**
+     * @brief Размер машинного кода в байтах (0 без JIT)
+     */
+    std::size_t CodeSize() const;
+
+    /**
+     * @brief Вычисляет выражение машинным кодом или интерпретатором
+     * @return Значение выражения; деление на ноль завершает программу
+     */
+    long long Evaluate();
+
+private:
+    BytecodeVM vm;
+    void* page = nullptr;
+    std::size_t page_size = 0;
+    std::size_t code_size = 0;
+    Function function = nullptr;
+};
+
+#endif // JITEXPRESSION_H
@@ -0,0 +1,245 @@
+/**
+ * @file PackedExpression.cpp
+ * @brief Реализация упаковки выражения в полубайты
+ */
+
+#include "PackedExpression.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "ExpressionTree.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+const char MAGIC[4] = {'C', 'T', 'P', 'K'};
+const unsigned char VERSION = 1;
+
+/// Значение токена по коду полубайта; код 0 также стоит на месте широкого литерала
+const long long NIBBLE_VALUE[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, ADD, SUB, MUL, DIV, MOD, POW};
+
+/// Код полубайта для значений -6..9, индекс — значение + 6
+const unsigned char NIBBLE_CODE[16] = {15, 14, 13, 12, 11, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+void PutU64(unsigned char* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+uint64_t GetU64(const unsigned char* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+void PutVarint(vector<unsigned char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+bool GetVarint(const unsigned char*& in, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        unsigned char byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Накопитель упакованного потока: полубайты и таблица широких литералов
+ */
+class PackWriter {
+public:
+    explicit PackWriter(size_t expected_tokens) {
+        nibbles.reserve(PackedExpression::HEADER_SIZE + expected_tokens / 2 + 1);
+        nibbles.resize(PackedExpression::HEADER_SIZE);
+    }
+
+    void Put(long long value) {
+        unsigned char code = 0;
+        if (value >= -6 && value <= 9) {
+            code = NIBBLE_CODE[value + 6];
+        } else {
+            // Широкий литерал: 0 в потоке, номер и значение в таблице
+            PutVarint(wide, count - next_wide);
+            PutVarint(wide, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+            next_wide = count + 1;
+            ++wide_count;
+        }
+        if (count & 1) {
+            nibbles.back() |= static_cast<unsigned char>(code << 4);
+        } else {
+            nibbles.push_back(code);
+        }
+        ++count;
+    }
+
+    vector<unsigned char> Finish() {
+        unsigned char* header = nibbles.data();
+        memcpy(header, MAGIC, sizeof(MAGIC));
+        header[4] = VERSION;
+        header[5] = header[6] = header[7] = 0;
+        PutU64(header + 8, count);
+        PutU64(header + 16, wide_count);
+
+        nibbles.insert(nibbles.end(), wide.begin(), wide.end());
+        size_t size = nibbles.size();
+        nibbles.resize(size + PackedExpression::CHECKSUM_SIZE);
+        PutU64(nibbles.data() + size, PackedExpression::Checksum(nibbles.data(), size));
+        return move(nibbles);
+    }
+
+private:
+    vector<unsigned char> nibbles;
+    vector<unsigned char> wide;
+    uint64_t count = 0;
+    uint64_t wide_count = 0;
+    uint64_t next_wide = 0;
+};
+
+} // namespace
+
+vector<unsigned char> PackedExpression::Encode(const vector<long long>& tokens) {
+    PackWriter writer(tokens.size());
+    for (long long value : tokens) writer.Put(value);
+    return writer.Finish();
+}
+
+vector<unsigned char> PackedExpression::Encode(const ExpressionTree& tree) {
+    PackWriter writer(0);
+    const TreeNode* current = tree.Root();
+    if (current) {
+        // Прямой порядок: спуск по левым детям, правые откладываются в стек
+        vector<const TreeNode*> st;
+        for (;;) {
+            writer.Put(current->value);
+            if (current->IsOperation()) {
+                st.push_back(current->right);
+                current = current->left;
+                continue;
+            }
+            if (st.empty()) break;
+            current = st.back(); st.pop_back();
+        }
+    }
+    return writer.Finish();
+}
+
+bool PackedExpression::IsPacked(const char* data, size_t size) {
+    return size >= HEADER_SIZE && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool PackedExpression::Decode(const unsigned char* data, size_t size, vector<long long>& tokens) {
+    if (!IsPacked(reinterpret_cast<const char*>(data), size) || size < HEADER_SIZE + CHECKSUM_SIZE) return false;
+    if (data[4] != VERSION) return false;
+    const unsigned char* end = data + size - CHECKSUM_SIZE;
+    if (Checksum(data, size - CHECKSUM_SIZE) != GetU64(end)) return false;
+
+    uint64_t count = GetU64(data + 8);
+    uint64_t wide_count = GetU64(data + 16);
+    uint64_t bytes = count / 2 + (count & 1);
+    if (bytes > static_cast<uint64_t>(end - data) - HEADER_SIZE) return false;
+
+    tokens.resize(count);
+    const unsigned char* in = data + HEADER_SIZE;
+    long long* out = tokens.data();
+    for (uint64_t i = 0; i < count / 2; ++i) {
+        unsigned char byte = in[i];
+        out[2 * i] = NIBBLE_VALUE[byte & 15];
+        out[2 * i + 1] = NIBBLE_VALUE[byte >> 4];
+    }
+    if (count & 1) out[count - 1] = NIBBLE_VALUE[in[count / 2] & 15];
+
+    // Исправления ставятся только на места нулевого кода
+    in += bytes;
+    uint64_t next = 0;
+    for (uint64_t k = 0; k < wide_count; ++k) {
+        uint64_t gap, zigzag;
+        if (!GetVarint(in, end, gap) || !GetVarint(in, end, zigzag)) return false;
+        if (gap >= count - next || out[next + gap] != 0) return false;
+        next += gap;
+        out[next++] = static_cast<long long>((zigzag >> 1) ^ (0 - (zigzag & 1)));
+    }
+    return in == end;
+}
+
+vector<long long> PackedExpression::ReadTokens(const string& file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Не удалось открыть файл: " << file_name << endl;
+        exit(1);
+    }
+
+    // Заголовок проверяется по первым байтам, текстовый файл дальше не читается
+    char magic[sizeof(MAGIC)];
+    if (pread(fd, magic, sizeof(magic), 0) != static_cast<ssize_t>(sizeof(magic)) ||
+        !IsPacked(magic, HEADER_SIZE)) {
+        close(fd);
+        return ExpressionTree::ReadExpression(file_name);
+    }
+
+    vector<unsigned char> data;
+    unsigned char chunk[1 << 16];
+    ssize_t got;
+    while ((got = read(fd, chunk, sizeof(chunk))) != 0) {
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    close(fd);
+
+    vector<long long> tokens;
+    if (!Decode(data.data(), data.size(), tokens)) {
+        cerr << "Поврежденный файл выражения: " << file_name << endl;
+        exit(1);
+    }
+    return tokens;
+}
+
+void PackedExpression::Save(const ExpressionTree& tree, const string& file_name) {
+    vector<unsigned char> data = Encode(tree);
+    int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        cerr << "Не удалось открыть файл: " << file_name << endl;
+        exit(1);
+    }
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t written = write(fd, data.data() + done, data.size() - done);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Ошибка записи файла: " << file_name << endl;
+            exit(1);
+        }
+        done += static_cast<size_t>(written);
+    }
+    close(fd);
+}
+
+uint64_t PackedExpression::Checksum(const unsigned char* data, size_t size) {
+    // Две суммы по модулю 2^64: слов и частичных сумм (порядок слов влияет на результат)
+    uint64_t a = 0, b = 0;
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        uint32_t word = static_cast<uint32_t>(data[i]) | static_cast<uint32_t>(data[i + 1]) << 8 |
+                        static_cast<uint32_t>(data[i + 2]) << 16 | static_cast<uint32_t>(data[i + 3]) << 24;
+        a += word;
+        b += a;
+    }
+    uint32_t tail = 0;
+    for (size_t shift = 0; i < size; ++i, shift += 8) tail |= static_cast<uint32_t>(data[i]) << shift;
+    a += tail;
+    b += a;
+    return a ^ (b << 32 | b >> 32);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file PackedExpression.h
+ * @brief Компактный двоичный формат выражения: по два токена в байте
+ */
+
+#ifndef PACKEDEXPRESSION_H
+#define PACKEDEXPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ExpressionTree;
+
+/**
+ * @brief Упаковка префиксной записи выражения в полубайты
+ *
+ * Цифры 0-9 и шесть операций занимают ровно 16 кодов полубайта: цифра
+ * кодируется собой, операция op — кодом 9 - op (ADD = 10, ..., POW = 15).
+ * Свободного кода для экранирования не остается, поэтому "широкий" литерал
+ * (число больше 9 или переменная) записывается в поток как 0, а его номер и
+ * значение — в таблицу исправлений после потока.
+ *
+ * Формат (все числа little-endian):
+ *   - заголовок 24 байта: "CTPK", версия (1 байт), 3 нулевых байта,
+ *     число токенов (8 байт), число широких литералов (8 байт);
+ *   - (токены + 1) / 2 байт полубайтов, первый токен — в младшем полубайте;
+ *   - таблица исправлений: для каждого широкого литерала varint разности
+ *     номеров и varint значения в zigzag-кодировании;
+ *   - контрольная сумма всего предыдущего (8 байт).
+ *
+ * ReadTokens читает как упакованные, так и текстовые файлы; его токены
+ * принимает конструктор любого представления дерева. Сам ExpressionTree о
+ * формате не знает.
+ */
+class PackedExpression {
+public:
+    /// Размер заголовка в байтах
+    static constexpr std::size_t HEADER_SIZE = 24;
+
+    /// Размер контрольной суммы в конце данных
+    static constexpr std::size_t CHECKSUM_SIZE = 8;
+
+    /**
+     * @brief Упаковывает токены префиксной записи
+     * @param tokens Вектор токенов
+     * @return Упакованные данные
+     */
+    static std::vector<unsigned char> Encode(const std::vector<long long>& tokens);
+
+    /**
+     * @brief Упаковывает дерево обходом в прямом порядке без промежуточных токенов
+     * @param tree Дерево выражения
+     * @return Упакованные данные
+     */
+    static std::vector<unsigned char> Encode(const ExpressionTree& tree);
+
+    /**
+     * @brief Проверяет, начинаются ли данные с заголовка формата
+     */
+    static bool IsPacked(const char* data, std::size_t size);
+
+    /**
+     * @brief Распаковывает токены для построения любого представления дерева
+     * @param data Упакованные данные
+     * @param size Их размер
+     * @param tokens Вектор-приемник (прежнее содержимое заменяется)
+     * @return false, если данные повреждены или имеют другую версию
+     */
+    static bool Decode(const unsigned char* data, std::size_t size, std::vector<long long>& tokens);
+
+    /**
+     * @brief Токены выражения из упакованного или текстового файла
+     *
+     * Формат определяется по заголовку; текст разбирает ExpressionTree::ReadExpression.
+     * Поврежденный упакованный файл — ошибка с завершением программы.
+     * @param file_name Имя файла
+     * @return Вектор токенов в префиксной форме
+     */
+    static std::vector<long long> ReadTokens(const std::string& file_name);
+
+    /**
+     * @brief Сохраняет дерево в файл в упакованном виде
+     * @param tree Дерево выражения
+     * @param file_name Имя файла
+     */
+    static void Save(const ExpressionTree& tree, const std::string& file_name);
+
+    /**
+     * @brief Контрольная сумма формата (Флетчер на 32-битных словах)
+     */
+    static std::uint64_t Checksum(const unsigned char* data, std::size_t size);
+};
+
+#endif // PACKEDEXPRESSION_H
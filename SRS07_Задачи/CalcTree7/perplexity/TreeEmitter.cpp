@@ -0,0 +1,241 @@
+/**
+ * @file TreeEmitter.cpp
+ * @brief Реализация вывода дерева выражения в текст
+ */
+
+#include "TreeEmitter.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+#include "ExpressionTree.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+/// Наибольший фрагмент за один шаг: число long long со знаком и пробел
+const size_t MAX_PIECE = 24;
+
+/**
+ * @brief Элемент стека обхода
+ *
+ * В префиксной форме — еще не выведенное правое поддерево. В инфиксной и
+ * постфиксной — операция, у которой пройдено левое поддерево (after_right
+ * false) или оба (true).
+ */
+struct Frame {
+    const TreeNode* node;
+    bool after_right;
+};
+
+char OperationSign(long long code) {
+    static const char SIGNS[] = {'+', '-', '*', '/', '%', '^'};
+    return SIGNS[-1 - code];
+}
+
+size_t DigitCount(long long value) {
+    if (value >= 0 && value <= 9) return 1;
+    char digits[MAX_PIECE];
+    return static_cast<size_t>(to_chars(digits, digits + MAX_PIECE, value).ptr - digits);
+}
+
+char* PutValue(char* out, long long value) {
+    if (value >= 0 && value <= 9) {
+        *out++ = static_cast<char>('0' + value);
+        return out;
+    }
+    return to_chars(out, out + MAX_PIECE, value).ptr;
+}
+
+/// Однобайтовые токены: операции POW..ADD и цифры, индекс — код + 6
+const char SHORT_TOKENS[16] = {'^', '%', '/', '*', '-', '+', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+bool IsShortToken(long long code) {
+    return code >= -6 && code <= 9;
+}
+
+/**
+ * @brief Записывает токен префиксной или постфиксной формы с пробелом после
+ */
+char* PutCode(char* out, long long code) {
+    if (IsShortToken(code)) {
+        out[0] = SHORT_TOKENS[code + 6];
+        out[1] = ' ';
+        return out + 2;
+    }
+    out = to_chars(out, out + MAX_PIECE, code).ptr;
+    *out++ = ' ';
+    return out;
+}
+
+/**
+ * @brief Обход в прямом порядке без ветвлений по виду узла
+ *
+ * На случайных деревьях ветвление "операция или лист" предсказывается плохо,
+ * поэтому правый ребенок записывается на стек всегда, а указатель стека
+ * сдвигается на 1 только у операций; следующий узел выбирается без перехода.
+ * Дно стека — nullptr: снятие его означает конец обхода.
+ */
+template <typename Visit>
+void WalkPreorder(const TreeNode* node, Visit visit) {
+    vector<const TreeNode*> st(64);
+    st[0] = nullptr;
+    size_t top = 1;
+    for (const TreeNode* current = node; current;) {
+        visit(current);
+        bool operation = current->IsOperation();
+        if (top + 1 >= st.size()) st.resize(2 * st.size());
+        st[top] = current->right;
+        top += operation;
+        const TreeNode* popped = st[top - 1];
+        current = operation ? current->left : popped;
+        top -= !operation;
+    }
+}
+
+/**
+ * @brief Записывает текст дерева начиная с out
+ *
+ * Спуск по левым детям идет без стека, глубина стека не больше высоты дерева.
+ * При выводе через буфер (flush не nullptr) перед каждой записью проверяется,
+ * что до end осталось не меньше MAX_PIECE байт; иначе вызывается flush,
+ * который возвращает новую позицию записи. Без flush буфер должен вмещать
+ * весь текст.
+ */
+template <TreeEmitter::Notation NOTATION, typename Flush>
+char* Emit(const TreeNode* node, char* out, char* end, Flush flush) {
+    if (!node) return out;
+
+    auto reserve = [&] {
+        if constexpr (!is_same<Flush, nullptr_t>::value) {
+            if (static_cast<size_t>(end - out) < MAX_PIECE) out = flush(out);
+        }
+    };
+
+    if constexpr (NOTATION == TreeEmitter::PREFIX) {
+        WalkPreorder(node, [&](const TreeNode* current) {
+            reserve();
+            out = PutCode(out, current->value);
+        });
+        return out;
+    }
+
+    // Инфиксная и постфиксная запись: операция остается в стеке до конца правого поддерева
+    vector<Frame> st;
+    const TreeNode* current = node;
+    for (;;) {
+        while (current->IsOperation()) {
+            reserve();
+            if (NOTATION == TreeEmitter::INFIX) *out++ = '(';
+            st.push_back({current, false});
+            current = current->left;
+        }
+
+        reserve();
+        out = PutValue(out, current->value);
+        if (NOTATION != TreeEmitter::INFIX) *out++ = ' ';
+
+        // Завершаем операции, у которых пройдены оба поддерева
+        for (;;) {
+            if (st.empty()) return out;
+            Frame& top = st.back();
+            if (!top.after_right) {
+                if (NOTATION == TreeEmitter::INFIX) {
+                    reserve();
+                    *out++ = ' ';
+                    *out++ = OperationSign(top.node->value);
+                    *out++ = ' ';
+                }
+                top.after_right = true;
+                current = top.node->right;
+                break;
+            }
+            reserve();
+            if (NOTATION == TreeEmitter::INFIX) {
+                *out++ = ')';
+            } else {
+                *out++ = OperationSign(top.node->value);
+                *out++ = ' ';
+            }
+            st.pop_back();
+        }
+    }
+}
+
+template <typename Flush>
+char* Emit(const TreeNode* node, TreeEmitter::Notation notation, char* out, char* end, Flush flush) {
+    switch (notation) {
+        case TreeEmitter::PREFIX: return Emit<TreeEmitter::PREFIX>(node, out, end, flush);
+        case TreeEmitter::INFIX: return Emit<TreeEmitter::INFIX>(node, out, end, flush);
+        default: return Emit<TreeEmitter::POSTFIX>(node, out, end, flush);
+    }
+}
+
+/**
+ * @brief Записывает весь диапазон, повторяя write при частичной записи
+ */
+void WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Ошибка записи результата" << endl;
+            exit(1);
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace
+
+TreeEmitter::TreeEmitter(size_t buffer_size) : buffer(max(buffer_size, 4 * MAX_PIECE)) {}
+
+size_t TreeEmitter::Length(const TreeNode* node, Notation notation) {
+    if (!node) return 0;
+
+    // Порядок обхода не важен: длина — сумма вкладов узлов. В префиксной и
+    // постфиксной формах короткий токен с пробелом занимает 2 байта
+    size_t length = 0, nodes = 0, operations = 0;
+    WalkPreorder(node, [&](const TreeNode* current) {
+        long long value = current->value;
+        length += IsShortToken(value) ? 2 : DigitCount(value) + 1;
+        ++nodes;
+        operations += current->IsOperation();
+    });
+
+    // В инфиксной "(" " op " ")" вместо "op " и операнды без пробелов
+    if (notation == INFIX) length = length + 3 * operations - (nodes - operations);
+    return length;
+}
+
+size_t TreeEmitter::Write(const TreeNode* node, Notation notation, char* out) {
+    char* end = Emit(node, notation, out, nullptr, nullptr);
+    return static_cast<size_t>(end - out);
+}
+
+void TreeEmitter::Write(const TreeNode* node, Notation notation, int fd) {
+    Flush(fd);
+    char* begin = buffer.data();
+    auto flush = [&](char* out) {
+        WriteAll(fd, begin, static_cast<size_t>(out - begin));
+        return begin;
+    };
+    char* out = Emit(node, notation, begin, begin + buffer.size(), flush);
+    WriteAll(fd, begin, static_cast<size_t>(out - begin));
+}
+
+void TreeEmitter::PutToken(long long code, int fd) {
+    if (buffer.size() - used < MAX_PIECE) Flush(fd);
+    used = static_cast<size_t>(PutCode(buffer.data() + used, code) - buffer.data());
+}
+
+void TreeEmitter::Flush(int fd) {
+    WriteAll(fd, buffer.data(), used);
+    used = 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file TreeEmitter.h
+ * @brief Вывод дерева выражения в префиксной, инфиксной и постфиксной формах
+ */
+
+#ifndef TREEEMITTER_H
+#define TREEEMITTER_H
+
+#include <cstddef>
+#include <vector>
+
+class TreeNode;
+
+/**
+ * @brief Сериализация дерева в текст без рекурсии и без потоков ввода-вывода
+ *
+ * Токены пишутся прямо в массив символов: однозначные операнды — одним байтом,
+ * остальные через std::to_chars. Длину результата можно узнать заранее (Length)
+ * и записать текст в буфер вызывающего; при выводе в дескриптор используется
+ * собственный буфер объекта, который сбрасывается крупными вызовами write.
+ *
+ * Формы: префиксная и постфиксная — токены через пробел с пробелом в конце
+ * (как в прежнем выводе), инфиксная — с полной расстановкой скобок:
+ * "((1 + 2) * 3)".
+ */
+class TreeEmitter {
+public:
+    enum Notation {
+        PREFIX,
+        INFIX,
+        POSTFIX
+    };
+
+    /**
+     * @brief Конструктор
+     * @param buffer_size Размер буфера для вывода в дескриптор
+     */
+    explicit TreeEmitter(std::size_t buffer_size = std::size_t{1} << 20);
+
+    /**
+     * @brief Точная длина текста дерева в заданной форме
+     * @param node Корень дерева (nullptr — пустой текст)
+     * @param notation Форма записи
+     */
+    static std::size_t Length(const TreeNode* node, Notation notation);
+
+    /**
+     * @brief Записывает текст в буфер вызывающего
+     * @param node Корень дерева
+     * @param notation Форма записи
+     * @param out Буфер не короче Length(node, notation)
+     * @return Число записанных байт
+     */
+    static std::size_t Write(const TreeNode* node, Notation notation, char* out);
+
+    /**
+     * @brief Выводит текст в дескриптор через внутренний буфер
+     * @param node Корень дерева
+     * @param notation Форма записи
+     * @param fd Дескриптор файла
+     */
+    void Write(const TreeNode* node, Notation notation, int fd);
+
+    /**
+     * @brief Добавляет токен префиксной или постфиксной формы (с пробелом после)
+     *
+     * Для представлений без узлов TreeNode: токены копятся в том же буфере и
+     * сбрасываются в дескриптор при его заполнении и в Flush.
+     * @param code Код операции или значение
+     * @param fd Дескриптор файла
+     */
+    void PutToken(long long code, int fd);
+
+    /**
+     * @brief Выводит накопленные PutToken токены
+     * @param fd Дескриптор файла
+     */
+    void Flush(int fd);
+
+private:
+    std::vector<char> buffer;
+    std::size_t used = 0;
+};
+
+#endif // TREEEMITTER_H
@@ -0,0 +1,93 @@
+/**
+ * @file WorkStealingScheduler.cpp
+ * @brief Реализация планировщика с перехватом работы
+ */
+
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+/// Номер потока внутри текущего Run
+thread_local unsigned current_worker = 0;
+
+} // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned threads)
+    : threads(threads ? threads : max(1u, thread::hardware_concurrency())) {
+    for (unsigned t = 0; t < this->threads; ++t) queues.push_back(make_unique<Queue>());
+}
+
+unsigned WorkStealingScheduler::ThreadCount() const {
+    return threads;
+}
+
+void WorkStealingScheduler::Run(const function<void()>& root) {
+    finished.store(false);
+
+    vector<thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back([this, t] {
+            current_worker = t;
+            while (!finished.load(memory_order_acquire)) {
+                if (!RunOne(t)) this_thread::yield();
+            }
+        });
+    }
+
+    unsigned saved = current_worker;
+    current_worker = 0;
+    root();
+    current_worker = saved;
+
+    finished.store(true, memory_order_release);
+    for (auto& t : pool) t.join();
+}
+
+void WorkStealingScheduler::Spawn(Group& group, function<void()> task) {
+    group.pending.fetch_add(1, memory_order_relaxed);
+    Queue& queue = *queues[current_worker];
+    lock_guard<mutex> lock(queue.mutex);
+    queue.tasks.push_back({move(task), &group});
+}
+
+void WorkStealingScheduler::Wait(Group& group) {
+    unsigned self = current_worker;
+    while (group.pending.load(memory_order_acquire) != 0) {
+        if (!RunOne(self)) this_thread::yield();
+    }
+}
+
+bool WorkStealingScheduler::RunOne(unsigned self) {
+    Task task;
+    bool found = false;
+
+    {
+        Queue& own = *queues[self];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    for (unsigned k = 1; !found && k < threads; ++k) {
+        Queue& victim = *queues[(self + k) % threads];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+    task.run();
+    task.group->pending.fetch_sub(1, memory_order_release);
+    return true;
+}
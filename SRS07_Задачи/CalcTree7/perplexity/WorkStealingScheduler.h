@@ -0,0 +1,89 @@
+/**
+ * @file WorkStealingScheduler.h
+ * @brief Планировщик задач fork-join с перехватом работы
+ */
+
+#ifndef WORKSTEALINGSCHEDULER_H
+#define WORKSTEALINGSCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Пул потоков на время одного вызова Run с очередью задач у каждого потока
+ *
+ * Поток кладет порожденные задачи в конец своей очереди и берет их оттуда же;
+ * свободный поток забирает самую старую задачу из начала чужой очереди — обычно
+ * самое крупное поддерево. Ожидающий группу поток не простаивает, а выполняет
+ * задачи сам, поэтому вложенные Spawn/Wait не блокируют пул.
+ */
+class WorkStealingScheduler {
+public:
+    /**
+     * @brief Набор задач, окончания которых ждет Wait
+     */
+    class Group {
+    private:
+        friend class WorkStealingScheduler;
+        std::atomic<std::size_t> pending{0};
+    };
+
+    /**
+     * @brief Конструктор
+     * @param threads Число потоков (0 — по числу ядер)
+     */
+    explicit WorkStealingScheduler(unsigned threads = 0);
+
+    /**
+     * @brief Число потоков, включая вызывающий
+     */
+    unsigned ThreadCount() const;
+
+    /**
+     * @brief Выполняет корневую задачу в вызывающем потоке, остальные потоки помогают
+     * @param root Задача; возвращается после ее завершения
+     */
+    void Run(const std::function<void()>& root);
+
+    /**
+     * @brief Порождает задачу; вызывается только изнутри Run
+     * @param group Группа, к которой относится задача
+     * @param task Задача
+     */
+    void Spawn(Group& group, std::function<void()> task);
+
+    /**
+     * @brief Дожидается всех задач группы, выполняя задачи пула
+     * @param group Группа
+     */
+    void Wait(Group& group);
+
+private:
+    struct Task {
+        std::function<void()> run;
+        Group* group = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    unsigned threads;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::atomic<bool> finished{false};
+
+    /**
+     * @brief Выполняет одну задачу: свою последнюю или самую старую чужую
+     * @param self Номер текущего потока
+     * @return false, если задач не нашлось
+     */
+    bool RunOne(unsigned self);
+};
+
+#endif // WORKSTEALINGSCHEDULER_H
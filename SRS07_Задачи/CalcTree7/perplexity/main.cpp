@@ -3,17 +3,23 @@
  * @brief Точка входа в программу решения задачи CalcTree7
  */
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BatchProcessor.h"
+#include "EditableExpressionTree.h"
+#include "ExpressionDag.h"
 #include "ExpressionTree.h"
+#include "FlatExpressionTree.h"
+#include "PackedExpression.h"
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Использование: " << argv[0] << " filename" << std::endl;
-        return 1;
-    }
-
-    ExpressionTree tree(argv[1]);
-
+/**
+ * @brief Читает, выводит, преобразует и снова выводит дерево любого представления
+ */
+template <typename Tree>
+void Run(Tree& tree) {
     std::cout << "Исходное дерево (префиксная форма): ";
     tree.PrintPrefix();
 
@@ -21,6 +27,84 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Преобразованное дерево (префиксная форма): ";
     tree.PrintPrefix();
+}
+
+int main(int argc, char* argv[]) {
+    // --batch: много выражений за один запуск, см. BatchProcessor
+    if (argc >= 2 && std::string(argv[1]) == "--batch") {
+        unsigned threads = 0;
+        std::vector<std::string> inputs;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--threads=", 0) == 0) {
+                threads = static_cast<unsigned>(std::strtoul(arg.c_str() + 10, nullptr, 10));
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+        if (inputs.empty()) {
+            std::cerr << "Использование: " << argv[0] << " --batch [--threads=N] path..." << std::endl;
+            return 1;
+        }
+        BatchProcessor(inputs).Run(threads);
+        return 0;
+    }
+
+    std::string mode = argc >= 3 ? argv[2] : "";
+    bool valid = argc == 2 || (argc == 3 && (mode == "--flat" || mode == "--dag" || mode == "--edit")) ||
+                 (argc == 4 && mode == "--pack");
+    if (!valid) {
+        std::cerr << "Использование: " << argv[0]
+                  << " filename [--flat|--dag|--edit|--pack output] | --batch [--threads=N] path..." << std::endl;
+        return 1;
+    }
+
+    // Файл в формате PackedExpression принимается вместо текстового во всех режимах
+    std::vector<long long> tokens = PackedExpression::ReadTokens(argv[1]);
+
+    // --pack: сохранить выражение в формате PackedExpression
+    if (mode == "--pack") {
+        ExpressionTree tree(tokens);
+        PackedExpression::Save(tree, argv[3]);
+        return 0;
+    }
+
+    // --flat: плоский массив в префиксном порядке вместо узлов со ссылками
+    if (mode == "--flat") {
+        FlatExpressionTree tree(std::move(tokens));
+        Run(tree);
+        return 0;
+    }
+
+    // --dag: одинаковые поддеревья хранятся и вычисляются один раз
+    if (mode == "--dag") {
+        ExpressionDag tree(tokens);
+        Run(tree);
+        return 0;
+    }
+
+    // --edit: правки листов "номер значение" из стандартного ввода, после каждой —
+    // значение выражения; пересчитывается только путь от листа к корню
+    if (mode == "--edit") {
+        EditableExpressionTree tree(std::move(tokens));
+        std::cout << "Исходное дерево (префиксная форма): ";
+        tree.PrintPrefix();
+
+        std::size_t index;
+        long long value;
+        while (std::cin >> index >> value) {
+            tree.SetLeaf(index, value);
+            std::cout << "Значение выражения: " << tree.Value() << '\n';
+        }
+
+        tree.TransformTree();
+        std::cout << "Преобразованное дерево (префиксная форма): ";
+        tree.PrintPrefix();
+        return 0;
+    }
+
+    ExpressionTree tree(tokens);
+    Run(tree);
 
     return 0;
 }
@@ -0,0 +1,69 @@
+/**
+ * @file GenerateGraph.cpp
+ * @brief Утилита генерации входных файлов Graf7
+ *
+ * Сборка (из каталога Graf7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/GenerateGraph.cpp bench/GraphGenerator.cpp \
+ *       perplexity/CsrGraph.cpp -o generate_graph
+ * Запуск: ./generate_graph er|grid|powerlaw size param output [matrix|csr] [seed]
+ *   er       — size: число вершин, param: средняя степень
+ *   grid     — size: сторона решётки, param: доля диагональных перемычек
+ *   powerlaw — size: число вершин, param: рёбер на новую вершину
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "GraphGenerator.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 5 || argc > 7) {
+        std::cerr << "Использование: " << argv[0]
+                  << " er|grid|powerlaw size param output [matrix|csr] [seed]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string kind = argv[1];
+    int size = std::atoi(argv[2]);
+    double param = std::atof(argv[3]);
+    std::string output = argv[4];
+    std::string format = argc > 5 ? argv[5] : "matrix";
+    std::uint64_t seed = argc > 6 ? std::strtoull(argv[6], nullptr, 10) : 1;
+
+    // Пустой граф и вырожденные параметры генераторы не поддерживают
+    bool valid = size >= 1;
+    if (kind == "er") valid = valid && param >= 0;
+    if (kind == "grid") valid = valid && param >= 0 && param <= 1;
+    if (kind == "powerlaw") valid = valid && param >= 1;
+    if (!valid) {
+        std::cerr << "Недопустимые параметры: size >= 1; er — param >= 0, grid — 0 <= param <= 1, "
+                  << "powerlaw — param >= 1\n"
+                  << "Использование: " << argv[0] << " er|grid|powerlaw size param output [matrix|csr] [seed]\n";
+        return EXIT_FAILURE;
+    }
+
+    CsrGraph graph;
+    if (kind == "er") {
+        graph = generateErdosRenyi(size, param, seed);
+    } else if (kind == "grid") {
+        graph = generateGrid(size, param, seed);
+    } else if (kind == "powerlaw") {
+        graph = generatePowerLaw(size, static_cast<int>(param), seed);
+    } else {
+        std::cerr << "Неизвестный тип графа: " << kind << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (format == "matrix") {
+        writeGraphMatrix(graph, output);
+    } else if (format == "csr") {
+        writeGraphBinary(graph, output);
+    } else {
+        std::cerr << "Неизвестный формат: " << format << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Вершин: " << graph.vertexCount() << ", дуг: " << graph.edgeCount() << '\n';
+    return 0;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file Graf7Bench.cpp
+ * @brief Замеры реализаций Graf7: загрузка, одиночные запросы и пачки запросов при разных L
+ *
+ * Каждая реализация собирается в отдельный бинарник (из каталога Graf7):
+ *   g++ -std=c++17 -O2 -pthread -DGRAF7_VARIANT_DEEPSEEK -Ideepseek -Iperplexity bench/Graf7Bench.cpp \
+ *       deepseek/GraphUtils.cpp perplexity/CsrGraph.cpp -o graf7_bench_deepseek
+ *   g++ -std=c++17 -O2 -pthread -DGRAF7_VARIANT_GPT35 -Igpt35 -Iperplexity bench/Graf7Bench.cpp \
+ *       gpt35/GraphUtils.cpp perplexity/CsrGraph.cpp -o graf7_bench_gpt35
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/Graf7Bench.cpp perplexity/GraphUtils.cpp \
+ *       perplexity/CsrGraph.cpp perplexity/CompressedGraph.cpp perplexity/TwinGraph.cpp \
+ *       perplexity/ReachabilityCache.cpp -o graf7_bench_perplexity
+ * Запуск: ./graf7_bench_<вариант> graph-file [queries] [L1,L2,...]
+ *
+ * Входные файлы готовит generate_graph. Матричные реализации читают только матрицу
+ * смежности; вариант perplexity дополнительно замеряет CSR-путь, который понимает и ".csr",
+ * обход по сжатому графу, обход по фактор-графу вершин-близнецов и кэш достижимости:
+ * пачки при разных L повторяют одни и те же начальные города, поэтому кэш доращивает
+ * сохранённые шары вместо обхода с нуля.
+ * Для каждого L печатаются задержка первого запроса, перцентили задержек пачки,
+ * пропускная способность, число просмотренных дуг в секунду и пиковый RSS.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "CompressedGraph.h"
+#include "CsrGraph.h"
+#include "GraphUtils.h"
+#include "ReachabilityCache.h"
+#include "TwinGraph.h"
+
+using namespace std;
+
+namespace {
+
+#if defined(GRAF7_VARIANT_DEEPSEEK)
+const char* const kVariant = "deepseek";
+
+vector<vector<int>> loadMatrix(const string& filename, int& n) {
+    return ReadGraph(filename, n);
+}
+
+set<int> findReachable(const vector<vector<int>>& graph, int start, int L) {
+    return FindReachableCities(graph, start, L);
+}
+#else
+#if defined(GRAF7_VARIANT_GPT35)
+const char* const kVariant = "gpt35";
+#else
+const char* const kVariant = "perplexity";
+#endif
+
+vector<vector<int>> loadMatrix(const string& filename, int& n) {
+    return readGraph(filename, n);
+}
+
+set<int> findReachable(const vector<vector<int>>& graph, int start, int L) {
+    return ReachableCitiesFinder()(graph, start, L);
+}
+#endif
+
+using Clock = chrono::steady_clock;
+
+// Ограничение памяти кэша достижимости в замере
+const size_t kCacheBytes = size_t{64} << 20;
+
+double elapsedUs(Clock::time_point from) {
+    return chrono::duration<double, micro>(Clock::now() - from).count();
+}
+
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+bool isBinaryGraph(const string& filename) {
+    return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csr") == 0;
+}
+
+/**
+ * @brief Число дуг, которые просматривает обход с ограничением L: сумма степеней вершин ближе L
+ */
+size_t traversedEdges(const CsrGraph& graph, int start, int L) {
+    vector<int> dist(graph.vertexCount(), -1);
+    vector<int> order{start};
+    dist[start] = 0;
+    size_t edges = 0;
+
+    for (size_t head = 0; head < order.size(); ++head) {
+        int city = order[head];
+        if (dist[city] >= L) continue;
+        edges += graph.offsets[city + 1] - graph.offsets[city];
+        for (size_t e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+            int neighbor = graph.neighbors[e];
+            if (dist[neighbor] < 0) {
+                dist[neighbor] = dist[city] + 1;
+                order.push_back(neighbor);
+            }
+        }
+    }
+
+    return edges;
+}
+
+double percentile(const vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+template <typename Query>
+void runQueries(const string& name, Query query, const CsrGraph& graph,
+                const vector<int>& starts, const vector<int>& levels) {
+    for (int L : levels) {
+        size_t edges = 0;
+        for (int s : starts) edges += traversedEdges(graph, s, L);
+
+        vector<double> latencies;
+        latencies.reserve(starts.size());
+        size_t checksum = 0;
+
+        auto batch_start = Clock::now();
+        for (int s : starts) {
+            auto t0 = Clock::now();
+            checksum += query(s, L);
+            latencies.push_back(elapsedUs(t0));
+        }
+        double batch_us = elapsedUs(batch_start);
+
+        double first = latencies.front();
+        sort(latencies.begin(), latencies.end());
+
+        cout << fixed << setprecision(1)
+             << name << "\tL=" << L
+             << "\tпервый " << first << " мкс"
+             << "\tp50 " << percentile(latencies, 0.50)
+             << "\tp90 " << percentile(latencies, 0.90)
+             << "\tp99 " << percentile(latencies, 0.99)
+             << "\tmax " << latencies.back() << " мкс"
+             << "\t" << starts.size() / (batch_us / 1e6) << " запр/с"
+             << "\t" << edges / (batch_us / 1e6) / 1e6 << " млн дуг/с"
+             << "\tRSS " << peakRssKb() << " КБ"
+             << "\t(вершин " << checksum << ")\n";
+    }
+}
+
+vector<int> parseLevels(const string& text) {
+    vector<int> levels;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) levels.push_back(atoi(item.c_str()));
+    }
+    return levels;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 4) {
+        cerr << "Использование: " << argv[0] << " graph-file [queries] [L1,L2,...]\n";
+        return EXIT_FAILURE;
+    }
+
+    string filename = argv[1];
+    int queries = argc > 2 ? atoi(argv[2]) : 100;
+    vector<int> levels = parseLevels(argc > 3 ? argv[3] : "1,2,4,8,16");
+    if (queries <= 0 || levels.empty()) {
+        cerr << "Число запросов должно быть положительным, а список L — непустым\n"
+             << "Использование: " << argv[0] << " graph-file [queries] [L1,L2,...]\n";
+        return EXIT_FAILURE;
+    }
+
+    cout << "Вариант: " << kVariant << '\n';
+    CsrGraph reference;
+    int n = 0;
+
+    if (!isBinaryGraph(filename)) {
+        auto t0 = Clock::now();
+        auto matrix = loadMatrix(filename, n);
+        cout << "Загрузка матрицы: " << elapsedUs(t0) / 1000 << " мс, RSS " << peakRssKb() << " КБ\n";
+
+        reference = buildCsr(matrix);
+        cout << "Вершин: " << n << ", дуг: " << reference.edgeCount() << '\n';
+        if (n <= 0) {
+            cerr << "В графе нет вершин: " << filename << '\n';
+            return EXIT_FAILURE;
+        }
+
+        mt19937 rng(7);
+        vector<int> starts(queries);
+        for (auto& s : starts) s = static_cast<int>(rng() % n);
+
+        runQueries("matrix", [&](int s, int L) { return findReachable(matrix, s, L).size(); },
+                   reference, starts, levels);
+    }
+
+#if !defined(GRAF7_VARIANT_DEEPSEEK) && !defined(GRAF7_VARIANT_GPT35)
+    auto t0 = Clock::now();
+    CsrGraph graph = loadGraph(filename, n);
+    cout << "Загрузка CSR: " << elapsedUs(t0) / 1000 << " мс, RSS " << peakRssKb() << " КБ\n";
+    cout << "Вершин: " << n << ", дуг: " << graph.edgeCount() << '\n';
+    if (n <= 0) {
+        cerr << "В графе нет вершин: " << filename << '\n';
+        return EXIT_FAILURE;
+    }
+
+    mt19937 rng(7);
+    vector<int> starts(queries);
+    for (auto& s : starts) s = static_cast<int>(rng() % n);
+
+    ParallelReachableCitiesFinder sequential(1);
+    ParallelReachableCitiesFinder parallel;
+    runQueries("csr-1", [&](int s, int L) { return sequential(graph, s, L).size(); },
+               graph, starts, levels);
+    runQueries("csr-par", [&](int s, int L) { return parallel(graph, s, L).size(); },
+               graph, starts, levels);
+
+    t0 = Clock::now();
+    CompressedGraph compressed(graph);
+    cout << "Сжатие: " << elapsedUs(t0) / 1000 << " мс, CSR " << csrBytes(graph) / 1024
+         << " КБ, сжатый " << compressed.bytes() / 1024 << " КБ ("
+         << static_cast<double>(csrBytes(graph)) / compressed.bytes() << "x)\n";
+
+    CompressedReachableCitiesFinder compressed_finder;
+    runQueries("csr-zip", [&](int s, int L) { return compressed_finder(compressed, s, L).size(); },
+               graph, starts, levels);
+
+    t0 = Clock::now();
+    TwinQuotientGraph quotient(graph);
+    cout << "Склейка близнецов: " << elapsedUs(t0) / 1000 << " мс, классов " << quotient.classCount()
+         << " из " << n << ", дуг " << quotient.quotient().edgeCount() << ", " << quotient.bytes() / 1024 << " КБ\n";
+
+    TwinReachableCitiesFinder twin_finder;
+    runQueries("csr-twin", [&](int s, int L) { return twin_finder(quotient, s, L).size(); },
+               graph, starts, levels);
+
+    ReachabilityCache cache(graph, kCacheBytes);
+    runQueries("csr-cache", [&](int s, int L) { return cache(s, L).size(); },
+               graph, starts, levels);
+    CacheStats stats = cache.stats();
+    cout << "Кэш: попаданий " << stats.hits << ", доращиваний " << stats.extensions
+         << ", промахов " << stats.misses << ", вытеснений " << stats.evictions
+         << ", записей " << stats.entries << ", " << stats.bytes / 1024 << " КБ\n";
+#endif
+
+    cout << "Пиковый RSS: " << peakRssKb() << " КБ\n";
+    return 0;
+}
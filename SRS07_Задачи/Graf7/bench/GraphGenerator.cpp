@@ -0,0 +1,137 @@
+/**
+ * @file GraphGenerator.cpp
+ * @brief Реализация генераторов синтетических графов
+ */
+
+#include "GraphGenerator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Собирает CSR из списков смежности, удаляя петли и повторные дуги
+ */
+CsrGraph fromRows(vector<vector<int>>& rows) {
+    CsrGraph graph;
+    graph.offsets.reserve(rows.size() + 1);
+    graph.offsets.push_back(0);
+
+    for (size_t v = 0; v < rows.size(); ++v) {
+        auto& row = rows[v];
+        sort(row.begin(), row.end());
+        row.erase(unique(row.begin(), row.end()), row.end());
+        for (int neighbor : row) {
+            if (neighbor != static_cast<int>(v)) graph.neighbors.push_back(neighbor);
+        }
+        graph.offsets.push_back(graph.neighbors.size());
+        vector<int>().swap(row);
+    }
+
+    return graph;
+}
+
+} // namespace
+
+CsrGraph generateErdosRenyi(int n, double average_degree, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> city(0, n - 1);
+    vector<vector<int>> rows(n);
+
+    long long edges = static_cast<long long>(average_degree * n / 2);
+    for (long long e = 0; e < edges; ++e) {
+        int a = city(rng);
+        int b = city(rng);
+        rows[a].push_back(b);
+        rows[b].push_back(a);
+    }
+
+    return fromRows(rows);
+}
+
+CsrGraph generateGrid(int side, double shortcut_share, uint64_t seed, bool shuffle_ids) {
+    mt19937_64 rng(seed);
+    bernoulli_distribution shortcut(shortcut_share);
+    int n = side * side;
+
+    vector<int> label(n);
+    iota(label.begin(), label.end(), 0);
+    if (shuffle_ids) shuffle(label.begin(), label.end(), rng);
+
+    vector<vector<int>> rows(n);
+    auto link = [&](int a, int b) {
+        rows[label[a]].push_back(label[b]);
+        rows[label[b]].push_back(label[a]);
+    };
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int v = r * side + c;
+            if (c + 1 < side) link(v, v + 1);
+            if (r + 1 < side) link(v, v + side);
+            if (r + 1 < side && c + 1 < side && shortcut(rng)) link(v, v + side + 1);
+        }
+    }
+
+    return fromRows(rows);
+}
+
+CsrGraph generatePowerLaw(int n, int edges_per_vertex, uint64_t seed) {
+    mt19937_64 rng(seed);
+    vector<vector<int>> rows(n);
+
+    // Каждая вершина входит в endpoints столько раз, какова её степень,
+    // поэтому равномерный выбор из endpoints — предпочтительное присоединение
+    vector<int> endpoints;
+    endpoints.reserve(static_cast<size_t>(n) * edges_per_vertex * 2);
+
+    int core = min(n, edges_per_vertex + 1);
+    for (int a = 0; a < core; ++a) {
+        for (int b = a + 1; b < core; ++b) {
+            rows[a].push_back(b);
+            rows[b].push_back(a);
+            endpoints.push_back(a);
+            endpoints.push_back(b);
+        }
+    }
+
+    for (int v = core; v < n; ++v) {
+        uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+        for (int k = 0; k < edges_per_vertex; ++k) {
+            int target = endpoints[pick(rng)];
+            rows[v].push_back(target);
+            rows[target].push_back(v);
+            endpoints.push_back(v);
+            endpoints.push_back(target);
+        }
+    }
+
+    return fromRows(rows);
+}
+
+void writeGraphMatrix(const CsrGraph& graph, const string& filename) {
+    ofstream file(filename);
+    if (!file) {
+        cerr << "Не удалось открыть файл: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    int n = graph.vertexCount();
+    file << n << '\n';
+
+    string line(2 * static_cast<size_t>(n), ' ');
+    for (int v = 0; v < n; ++v) {
+        for (int j = 0; j < n; ++j) line[2 * j] = '0';
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            line[2 * graph.neighbors[e]] = '1';
+        }
+        line.back() = '\n';
+        file << line;
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * @file GraphGenerator.h
+ * @brief Генераторы синтетических графов для замеров Graf7
+ */
+
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Случайный граф Эрдёша — Реньи (неориентированный)
+ * @param n Количество вершин
+ * @param average_degree Средняя степень вершины
+ * @param seed Зерно генератора
+ * @return Граф в формате CSR
+ */
+CsrGraph generateErdosRenyi(int n, double average_degree, std::uint64_t seed);
+
+/**
+ * @brief Решётка side x side, похожая на дорожную сеть
+ * @param side Сторона решётки
+ * @param shortcut_share Доля клеток с диагональной перемычкой
+ * @param seed Зерно генератора
+ * @param shuffle_ids Перемешать номера вершин, как в реальных входных матрицах
+ * @return Граф в формате CSR
+ */
+CsrGraph generateGrid(int side, double shortcut_share, std::uint64_t seed, bool shuffle_ids = true);
+
+/**
+ * @brief Граф со степенным распределением степеней (модель Барабаши — Альберт)
+ * @param n Количество вершин
+ * @param edges_per_vertex Число рёбер, которые приносит каждая новая вершина
+ * @param seed Зерно генератора
+ * @return Граф в формате CSR
+ */
+CsrGraph generatePowerLaw(int n, int edges_per_vertex, std::uint64_t seed);
+
+/**
+ * @brief Записывает граф в формате исходной задачи: n, затем матрица смежности n x n
+ * @param graph Граф в формате CSR
+ * @param filename Имя файла
+ */
+void writeGraphMatrix(const CsrGraph& graph, const std::string& filename);
+
+#endif // GRAPHGENERATOR_H
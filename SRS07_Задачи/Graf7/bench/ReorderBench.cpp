@@ -0,0 +1,72 @@
+/**
+ * @file ReorderBench.cpp
+ * @brief Замер влияния перенумерации вершин на обход в ширину с ограничением L
+ *
+ * Сборка (из каталога Graf7):
+ *   g++ -std=c++17 -O2 -pthread -Iperplexity bench/ReorderBench.cpp bench/GraphGenerator.cpp \
+ *       perplexity/CsrGraph.cpp perplexity/VertexOrdering.cpp -o reorder_bench
+ * Запуск: ./reorder_bench [side] [queries]
+ *
+ * Граф — решётка side x side с диагональными перемычками (похожа на дорожную сеть)
+ * со случайно перемешанными номерами вершин, как в реальных входных матрицах.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "GraphGenerator.h"
+#include "VertexOrdering.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? atoi(argv[1]) : 1000;
+    int queries = argc > 2 ? atoi(argv[2]) : 200;
+    if (side <= 0 || queries <= 0) {
+        cerr << "Использование: " << argv[0] << " [side] [queries] (оба числа положительные)\n";
+        return EXIT_FAILURE;
+    }
+
+    mt19937 rng(42);
+    CsrGraph original = generateGrid(side, 0.125, 42);
+    cout << "Вершин: " << original.vertexCount() << ", дуг: " << original.edgeCount() << '\n';
+
+    vector<int> starts(queries);
+    for (auto& s : starts) s = static_cast<int>(rng() % original.vertexCount());
+
+    const pair<const char*, VertexOrder> orders[] = {
+        {"none", VertexOrder::Original},
+        {"bfs", VertexOrder::Bfs},
+        {"rcm", VertexOrder::ReverseCuthillMcKee},
+        {"degree", VertexOrder::DegreeSorted},
+    };
+    ParallelReachableCitiesFinder finder(1);
+
+    for (const auto& [name, order] : orders) {
+        CsrGraph graph = original;
+        auto t0 = chrono::steady_clock::now();
+        VertexPermutation permutation = reorderGraph(graph, order);
+        auto t1 = chrono::steady_clock::now();
+
+        for (int L : {4, 16, 64}) {
+            size_t checksum = 0;
+            auto q0 = chrono::steady_clock::now();
+            for (int s : starts) {
+                auto bitmap = finder.reachableBitmap(graph, permutation.new_id[s], L);
+                for (auto word : bitmap) checksum += __builtin_popcountll(word);
+            }
+            auto q1 = chrono::steady_clock::now();
+            cout << name
+                 << "\tперенумерация " << chrono::duration<double, milli>(t1 - t0).count() << " мс"
+                 << "\tL=" << L
+                 << "\tзапрос " << chrono::duration<double, micro>(q1 - q0).count() / queries << " мкс"
+                 << "\t(вершин " << checksum << ")\n";
+        }
+    }
+
+    return 0;
+}
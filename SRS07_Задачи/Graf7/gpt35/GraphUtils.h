@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <set>
+#include <string>
 
 /**
  * @brief Функциональный объект для поиска достижимых городов
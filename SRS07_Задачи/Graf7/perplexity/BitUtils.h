@@ -0,0 +1,50 @@
+/**
+ * @file BitUtils.h
+ * @brief Общие битовые операции и перемешивающая хеш-функция
+ */
+
+#ifndef BITUTILS_H
+#define BITUTILS_H
+
+#include <cstdint>
+
+/**
+ * @brief Перемешивает биты 64-битного числа (финализатор splitmix64)
+ */
+inline uint64_t mixHash(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Номер младшего единичного бита; word не должно быть нулём
+ */
+inline int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Число ведущих нулевых битов (64 для нуля)
+ */
+inline int leadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return x ? __builtin_clzll(x) : 64;
+#else
+    int zeros = 0;
+    for (uint64_t bit = uint64_t{1} << 63; bit && !(x & bit); bit >>= 1) ++zeros;
+    return zeros;
+#endif
+}
+
+#endif // BITUTILS_H
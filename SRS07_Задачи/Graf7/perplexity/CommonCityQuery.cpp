@@ -0,0 +1,172 @@
+/**
+ * @file CommonCityQuery.cpp
+ * @brief Реализация запросов об общих городах с досрочной остановкой
+ */
+
+#include "CommonCityQuery.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Поуровневый обход в ширину с ограничением, который можно продвигать по одному уровню
+ */
+class BoundedSearch {
+public:
+    BoundedSearch(int n, int start)
+        : visited_((static_cast<size_t>(n) + 63) / 64, 0), frontier_{start}, reached_{start} {
+        mark(start);
+    }
+
+    bool contains(int v) const {
+        return visited_[v >> 6] & (uint64_t{1} << (v & 63));
+    }
+
+    bool finished(int L) const {
+        return frontier_.empty() || level_ >= L;
+    }
+
+    size_t frontierSize() const {
+        return frontier_.size();
+    }
+
+    const vector<int>& reached() const {
+        return reached_;
+    }
+
+    /**
+     * @brief Открывает следующий уровень
+     * @param on_discover Вызывается для каждой новой вершины; false — остановить обход
+     * @return false, если обход остановлен обработчиком
+     */
+    template <typename OnDiscover>
+    bool expand(const CsrGraph& graph, OnDiscover on_discover) {
+        next_.clear();
+        for (int city : frontier_) {
+            for (size_t e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+                int neighbor = graph.neighbors[e];
+                if (contains(neighbor)) continue;
+                mark(neighbor);
+                next_.push_back(neighbor);
+                reached_.push_back(neighbor);
+                if (!on_discover(neighbor)) return false;
+            }
+        }
+        frontier_.swap(next_);
+        ++level_;
+        return true;
+    }
+
+private:
+    void mark(int v) {
+        visited_[v >> 6] |= uint64_t{1} << (v & 63);
+    }
+
+    vector<uint64_t> visited_;
+    vector<int> frontier_;
+    vector<int> next_;
+    vector<int> reached_;
+    int level_ = 0;
+};
+
+/**
+ * @brief Продвигает два обхода поуровнево, каждый раз выбирая незавершённый с меньшим фронтом
+ * @param after_level Вызывается после каждого уровня; true — ответ известен, остановиться
+ */
+template <typename OnDiscoverA, typename OnDiscoverB, typename AfterLevel>
+void interleave(const CsrGraph& graph, BoundedSearch& a, BoundedSearch& b, int L,
+                OnDiscoverA on_discover_a, OnDiscoverB on_discover_b, AfterLevel after_level) {
+    while (!a.finished(L) || !b.finished(L)) {
+        bool advance_a = b.finished(L) || (!a.finished(L) && a.frontierSize() <= b.frontierSize());
+        bool running = advance_a ? a.expand(graph, on_discover_a) : b.expand(graph, on_discover_b);
+        if (!running || after_level()) return;
+    }
+}
+
+} // namespace
+
+bool hasCommonCity(const CsrGraph& graph, int k1, int k2, int L) {
+    if (k1 == k2) return true;
+
+    BoundedSearch a(graph.vertexCount(), k1);
+    BoundedSearch b(graph.vertexCount(), k2);
+    bool found = false;
+
+    interleave(graph, a, b, L,
+        [&](int v) { found = b.contains(v); return !found; },
+        [&](int v) { found = a.contains(v); return !found; },
+        [] { return false; });
+
+    return found;
+}
+
+size_t countCommonCities(const CsrGraph& graph, int k1, int k2, int L) {
+    BoundedSearch a(graph.vertexCount(), k1);
+    BoundedSearch b(graph.vertexCount(), k2);
+    size_t count = k1 == k2 ? 1 : 0;
+
+    interleave(graph, a, b, L,
+        [&](int v) { count += b.contains(v); return true; },
+        [&](int v) { count += a.contains(v); return true; },
+        [] { return false; });
+
+    return count;
+}
+
+vector<int> topCommonCities(const CsrGraph& graph, int k1, int k2, int L, size_t k,
+                            const vector<int>& order_key) {
+    auto key = [&](int v) { return order_key.empty() ? v : order_key[v]; };
+    auto by_key = [&](int x, int y) { return key(x) < key(y); };
+
+    BoundedSearch a(graph.vertexCount(), k1);
+    BoundedSearch b(graph.vertexCount(), k2);
+    vector<int> result;
+    if (k == 0) return result;
+
+    // Множество завершённого обхода, отсортированное по ключу (строится один раз)
+    vector<int> complete;
+    const BoundedSearch* complete_side = nullptr;
+    const BoundedSearch* other_side = nullptr;
+
+    auto answer_known = [&] {
+        if (!complete_side) {
+            if (a.finished(L)) {
+                complete_side = &a;
+                other_side = &b;
+            } else if (b.finished(L)) {
+                complete_side = &b;
+                other_side = &a;
+            } else {
+                return false;
+            }
+            complete = complete_side->reached();
+            sort(complete.begin(), complete.end(), by_key);
+        }
+
+        // Город, ещё не отмеченный незавершённым обходом, может быть открыт позже,
+        // поэтому ответ известен, только если первые k общих идут без таких пропусков
+        result.clear();
+        for (int v : complete) {
+            if (other_side->contains(v)) {
+                result.push_back(v);
+                if (result.size() == k) return true;
+            } else if (!other_side->finished(L)) {
+                return false;
+            }
+        }
+        return other_side->finished(L);
+    };
+
+    if (!answer_known()) {
+        interleave(graph, a, b, L,
+            [](int) { return true; },
+            [](int) { return true; },
+            answer_known);
+        answer_known();
+    }
+
+    return result;
+}
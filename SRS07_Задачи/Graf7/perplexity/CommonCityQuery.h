@@ -0,0 +1,57 @@
+/**
+ * @file CommonCityQuery.h
+ * @brief Запросы об общих городах с досрочной остановкой: существование, количество, первые k
+ */
+
+#ifndef COMMONCITYQUERY_H
+#define COMMONCITYQUERY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Проверяет, есть ли город, достижимый из K1 и из K2 не более чем за L пересадок
+ *
+ * Два ограниченных обхода идут поуровнево вперемешку (сначала тот, у кого меньше фронт);
+ * при открытии вершины проверяется отметка другого обхода, и поиск останавливается
+ * на первом совпадении.
+ * @param graph Граф в формате CSR
+ * @param k1 Первый город (0-based индекс)
+ * @param k2 Второй город (0-based индекс)
+ * @param L Максимальное число пересадок
+ * @return true, если общий город существует
+ */
+bool hasCommonCity(const CsrGraph& graph, int k1, int k2, int L);
+
+/**
+ * @brief Считает общие города, не строя сами множества
+ *
+ * Каждый общий город учитывается в момент, когда его открывает второй из обходов.
+ * @param graph Граф в формате CSR
+ * @param k1 Первый город (0-based индекс)
+ * @param k2 Второй город (0-based индекс)
+ * @param L Максимальное число пересадок
+ * @return Количество общих городов
+ */
+std::size_t countCommonCities(const CsrGraph& graph, int k1, int k2, int L);
+
+/**
+ * @brief Находит k общих городов с наименьшими номерами
+ *
+ * Когда один из обходов исчерпан, его множество известно полностью; если первые k
+ * его городов (по ключу) уже отмечены другим обходом, поиск останавливается.
+ * @param graph Граф в формате CSR
+ * @param k1 Первый город (0-based индекс)
+ * @param k2 Второй город (0-based индекс)
+ * @param L Максимальное число пересадок
+ * @param k Сколько городов нужно
+ * @param order_key Номер, по которому сравниваются вершины (пусто — внутренний номер);
+ *                  при перенумерации сюда передаётся VertexPermutation::old_id
+ * @return До k общих городов (0-based индексы), упорядоченных по ключу
+ */
+std::vector<int> topCommonCities(const CsrGraph& graph, int k1, int k2, int L, std::size_t k,
+                                 const std::vector<int>& order_key = {});
+
+#endif // COMMONCITYQUERY_H
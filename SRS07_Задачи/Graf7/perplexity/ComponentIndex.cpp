@@ -0,0 +1,238 @@
+/**
+ * @file ComponentIndex.cpp
+ * @brief Реализация индекса компонент связности и оценок эксцентриситетов
+ */
+
+#include "ComponentIndex.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// Вершин в одной порции параллельного объединения
+const int kChunkSize = 1024;
+
+/**
+ * @brief Непересекающиеся множества на атомарных ссылках на родителя
+ *
+ * Корень с большим номером подвешивается к меньшему через compare_exchange,
+ * поиск выполняет деление пути пополам; операции можно вызывать из разных потоков.
+ */
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(int n) : parent_(new atomic<int>[n]) {
+        for (int v = 0; v < n; ++v) parent_[v].store(v, memory_order_relaxed);
+    }
+
+    int find(int v) const {
+        for (;;) {
+            int p = parent_[v].load(memory_order_relaxed);
+            if (p == v) return v;
+            int grand = parent_[p].load(memory_order_relaxed);
+            if (p != grand) parent_[v].compare_exchange_weak(p, grand, memory_order_relaxed);
+            v = grand;
+        }
+    }
+
+    void unite(int a, int b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) swap(a, b);
+            int expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, memory_order_relaxed)) return;
+        }
+    }
+
+private:
+    unique_ptr<atomic<int>[]> parent_;
+};
+
+bool isSymmetric(const CsrGraph& graph) {
+    for (int v = 0; v < graph.vertexCount(); ++v) {
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            int u = graph.neighbors[e];
+            auto begin = graph.neighbors.begin() + graph.offsets[u];
+            auto end = graph.neighbors.begin() + graph.offsets[u + 1];
+            if (!binary_search(begin, end, v)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Обход в ширину сразу из нескольких источников (по одному на компоненту)
+ */
+void multiSourceBfs(const CsrGraph& graph, const vector<int>& sources, vector<int>& dist) {
+    fill(dist.begin(), dist.end(), -1);
+    vector<int> order;
+    order.reserve(graph.vertexCount());
+    for (int s : sources) {
+        dist[s] = 0;
+        order.push_back(s);
+    }
+
+    for (size_t head = 0; head < order.size(); ++head) {
+        int city = order[head];
+        for (size_t e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+            int neighbor = graph.neighbors[e];
+            if (dist[neighbor] < 0) {
+                dist[neighbor] = dist[city] + 1;
+                order.push_back(neighbor);
+            }
+        }
+    }
+}
+
+} // namespace
+
+ComponentIndex::ComponentIndex(const CsrGraph& graph, int sweeps, unsigned threads)
+    : n_(graph.vertexCount()) {
+    if (!threads) threads = max(1u, thread::hardware_concurrency());
+
+    ConcurrentUnionFind sets(n_);
+    atomic<int> cursor{0};
+    auto worker = [&] {
+        for (;;) {
+            int begin = cursor.fetch_add(kChunkSize, memory_order_relaxed);
+            if (begin >= n_) break;
+            int end = min(n_, begin + kChunkSize);
+            for (int v = begin; v < end; ++v) {
+                for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                    sets.unite(v, graph.neighbors[e]);
+                }
+            }
+        }
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    // Плотная нумерация компонент в порядке наименьших вершин
+    component_.assign(n_, -1);
+    vector<int> root_id(n_, -1);
+    int count = 0;
+    for (int v = 0; v < n_; ++v) {
+        int root = sets.find(v);
+        if (root_id[root] < 0) root_id[root] = count++;
+        component_[v] = root_id[root];
+    }
+
+    member_offsets_.assign(count + 1, 0);
+    for (int v = 0; v < n_; ++v) ++member_offsets_[component_[v] + 1];
+    for (int c = 0; c < count; ++c) member_offsets_[c + 1] += member_offsets_[c];
+    members_.resize(n_);
+    vector<int> fill_pos(member_offsets_.begin(), member_offsets_.end() - 1);
+    for (int v = 0; v < n_; ++v) members_[fill_pos[component_[v]]++] = v;
+
+    symmetric_ = isSymmetric(graph);
+    if (symmetric_) {
+        computeEccentricityBounds(graph, max(1, sweeps));
+    }
+}
+
+bool ComponentIndex::symmetric() const {
+    return symmetric_;
+}
+
+int ComponentIndex::componentCount() const {
+    return static_cast<int>(member_offsets_.size()) - 1;
+}
+
+int ComponentIndex::component(int v) const {
+    return component_[v];
+}
+
+int ComponentIndex::componentSize(int c) const {
+    return member_offsets_[c + 1] - member_offsets_[c];
+}
+
+vector<int> ComponentIndex::componentMembers(int c) const {
+    return vector<int>(members_.begin() + member_offsets_[c], members_.begin() + member_offsets_[c + 1]);
+}
+
+vector<uint64_t> ComponentIndex::componentBitmap(int c) const {
+    vector<uint64_t> bitmap((static_cast<size_t>(n_) + 63) / 64, 0);
+    for (int i = member_offsets_[c]; i < member_offsets_[c + 1]; ++i) {
+        bitmap[members_[i] >> 6] |= uint64_t{1} << (members_[i] & 63);
+    }
+    return bitmap;
+}
+
+int ComponentIndex::eccentricityBound(int v) const {
+    return symmetric_ ? ecc_bound_[v] : -1;
+}
+
+bool ComponentIndex::coversComponent(int v, int L) const {
+    return symmetric_ && L >= ecc_bound_[v];
+}
+
+CommonCityShortcut ComponentIndex::shortcut(int k1, int k2, int L) const {
+    if (component_[k1] != component_[k2]) return CommonCityShortcut::Disjoint;
+
+    bool first = coversComponent(k1, L);
+    bool second = coversComponent(k2, L);
+    if (first && second) return CommonCityShortcut::BothCover;
+    if (first) return CommonCityShortcut::FirstCovers;
+    if (second) return CommonCityShortcut::SecondCovers;
+    return CommonCityShortcut::None;
+}
+
+void ComponentIndex::computeEccentricityBounds(const CsrGraph& graph, int sweeps) {
+    int count = componentCount();
+    ecc_bound_.assign(n_, INT_MAX);
+
+    // Первый источник в каждой компоненте — вершина наибольшей степени
+    vector<int> sources(count, -1);
+    for (int v = 0; v < n_; ++v) {
+        int& s = sources[component_[v]];
+        if (s < 0 || graph.offsets[v + 1] - graph.offsets[v] > graph.offsets[s + 1] - graph.offsets[s]) {
+            s = v;
+        }
+    }
+
+    vector<int> dist(n_);
+    vector<int> previous(n_);
+    vector<int> ecc(count);
+    vector<int> farthest(count);
+
+    for (int round = 0; round < sweeps; ++round) {
+        multiSourceBfs(graph, sources, dist);
+
+        fill(ecc.begin(), ecc.end(), -1);
+        for (int v = 0; v < n_; ++v) {
+            int c = component_[v];
+            if (dist[v] > ecc[c]) {
+                ecc[c] = dist[v];
+                farthest[c] = v;
+            }
+        }
+        for (int v = 0; v < n_; ++v) {
+            ecc_bound_[v] = min(ecc_bound_[v], dist[v] + ecc[component_[v]]);
+        }
+
+        // Следующий источник — самая дальняя вершина, последний — «середина»
+        // между двумя предыдущими источниками (схема четырёх обходов)
+        if (round + 2 == sweeps && round >= 1) {
+            vector<int> best(count, INT_MAX);
+            for (int v = 0; v < n_; ++v) {
+                int c = component_[v];
+                int spread = max(dist[v], previous[v]);
+                if (spread < best[c]) {
+                    best[c] = spread;
+                    sources[c] = v;
+                }
+            }
+        } else {
+            sources = farthest;
+        }
+        previous.swap(dist);
+    }
+}
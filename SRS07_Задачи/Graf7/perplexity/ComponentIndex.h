@@ -0,0 +1,103 @@
+/**
+ * @file ComponentIndex.h
+ * @brief Компоненты связности и верхние оценки эксцентриситетов для ответа на запросы без обхода
+ */
+
+#ifndef COMPONENTINDEX_H
+#define COMPONENTINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Что известно об ответе на запрос (K1, K2, L) до обхода
+ */
+enum class CommonCityShortcut {
+    None,          ///< Нужен обычный обход
+    Disjoint,      ///< K1 и K2 в разных компонентах: общих городов нет
+    BothCover,     ///< Оба шара совпадают с общей компонентой
+    FirstCovers,   ///< Шар K1 — вся компонента, ответ — шар K2
+    SecondCovers   ///< Шар K2 — вся компонента, ответ — шар K1
+};
+
+/**
+ * @brief Индекс компонент связности, строящийся при загрузке графа
+ *
+ * Компоненты (слабой связности) находятся параллельным непересекающимся
+ * объединением множеств. Шар любой вершины лежит внутри её компоненты, поэтому
+ * вершины из разных компонент не имеют общих городов. Для симметричного графа
+ * (матрицы неориентированной сети) несколько обходов в ширину дают верхние оценки
+ * эксцентриситета ecc(v) <= d(s, v) + ecc(s); при L >= оценки шар вершины — вся её компонента.
+ */
+class ComponentIndex {
+public:
+    /**
+     * @brief Строит индекс
+     * @param graph Граф в формате CSR
+     * @param sweeps Число обходов для оценок эксцентриситета
+     * @param threads Число потоков для объединения множеств (0 — по числу ядер)
+     */
+    explicit ComponentIndex(const CsrGraph& graph, int sweeps = 4, unsigned threads = 0);
+
+    /**
+     * @brief Симметричен ли граф (для каждой дуги u -> v есть дуга v -> u)
+     */
+    bool symmetric() const;
+
+    /**
+     * @brief Количество компонент
+     */
+    int componentCount() const;
+
+    /**
+     * @brief Номер компоненты вершины
+     */
+    int component(int v) const;
+
+    /**
+     * @brief Число вершин компоненты
+     */
+    int componentSize(int c) const;
+
+    /**
+     * @brief Вершины компоненты по возрастанию номеров
+     */
+    std::vector<int> componentMembers(int c) const;
+
+    /**
+     * @brief Битовая карта вершин компоненты
+     */
+    std::vector<std::uint64_t> componentBitmap(int c) const;
+
+    /**
+     * @brief Верхняя оценка эксцентриситета вершины (-1, если граф несимметричен)
+     */
+    int eccentricityBound(int v) const;
+
+    /**
+     * @brief Совпадает ли шар радиуса L вокруг v с компонентой v
+     */
+    bool coversComponent(int v, int L) const;
+
+    /**
+     * @brief Определяет, можно ли ответить на запрос об общих городах без обхода
+     * @param k1 Первый город (0-based индекс)
+     * @param k2 Второй город (0-based индекс)
+     * @param L Максимальное число пересадок
+     */
+    CommonCityShortcut shortcut(int k1, int k2, int L) const;
+
+private:
+    void computeEccentricityBounds(const CsrGraph& graph, int sweeps);
+
+    int n_ = 0;
+    bool symmetric_ = false;
+    std::vector<int> component_;
+    std::vector<int> member_offsets_;
+    std::vector<int> members_;
+    std::vector<int> ecc_bound_;
+};
+
+#endif // COMPONENTINDEX_H
@@ -0,0 +1,256 @@
+/**
+ * @file CompressedGraph.cpp
+ * @brief Реализация сжатого графа и обхода по нему
+ */
+
+#include "CompressedGraph.h"
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define COMPRESSEDGRAPH_SSSE3 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const int kBlockBits = 6;
+
+// Запас в конце данных: векторное декодирование читает по 16 байт
+const size_t kPadding = 16;
+
+uint32_t zigzag(int64_t value) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+int64_t unzigzag(uint32_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void writeVarint(vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t readVarint(const uint8_t*& p) {
+    uint32_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+}
+
+int byteLength(uint32_t value) {
+    if (value < (1u << 8)) return 1;
+    if (value < (1u << 16)) return 2;
+    if (value < (1u << 24)) return 3;
+    return 4;
+}
+
+/**
+ * @brief Скалярное декодирование значений [from, degree) списка
+ * @param prev Последнее уже декодированное значение (для from > 0)
+ */
+void decodeScalar(const uint8_t* control, const uint8_t* data, int v, int from, int degree,
+                  uint32_t prev, int* out) {
+    for (int i = from; i < degree; ++i) {
+        int length = ((control[i >> 2] >> (2 * (i & 3))) & 3) + 1;
+        uint32_t value = 0;
+        for (int b = 0; b < length; ++b) {
+            value |= static_cast<uint32_t>(data[b]) << (8 * b);
+        }
+        data += length;
+        prev = i == 0 ? static_cast<uint32_t>(v + unzigzag(value)) : prev + value;
+        out[i] = static_cast<int>(prev);
+    }
+}
+
+#ifdef COMPRESSEDGRAPH_SSSE3
+
+/**
+ * @brief Таблицы Stream VByte: маска pshufb и суммарная длина для каждого управляющего байта
+ */
+struct ShuffleTables {
+    alignas(16) uint8_t masks[256][16];
+    uint8_t lengths[256];
+
+    ShuffleTables() {
+        for (int control = 0; control < 256; ++control) {
+            int source = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                int length = ((control >> (2 * lane)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) {
+                    masks[control][4 * lane + b] = b < length ? static_cast<uint8_t>(source++) : 0x80;
+                }
+            }
+            lengths[control] = static_cast<uint8_t>(source);
+        }
+    }
+};
+
+const ShuffleTables& shuffleTables() {
+    static const ShuffleTables tables;
+    return tables;
+}
+
+__attribute__((target("ssse3")))
+void decodeSsse3(const uint8_t* control, const uint8_t* data, int v, int degree, int* out) {
+    const ShuffleTables& tables = shuffleTables();
+    const __m128i tail_lanes = _mm_set_epi32(-1, -1, -1, 0);
+    __m128i prev = _mm_setzero_si128();
+    int groups = degree / 4;
+
+    for (int g = 0; g < groups; ++g) {
+        uint8_t c = control[g];
+        __m128i raw = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                       _mm_load_si128(reinterpret_cast<const __m128i*>(tables.masks[c])));
+        data += tables.lengths[c];
+
+        if (g == 0) {
+            uint32_t first = static_cast<uint32_t>(v + unzigzag(static_cast<uint32_t>(_mm_cvtsi128_si32(raw))));
+            raw = _mm_or_si128(_mm_and_si128(raw, tail_lanes), _mm_cvtsi32_si128(static_cast<int>(first)));
+        }
+
+        // Префиксная сумма четырёх 32-битных дорожек
+        raw = _mm_add_epi32(raw, _mm_slli_si128(raw, 4));
+        raw = _mm_add_epi32(raw, _mm_slli_si128(raw, 8));
+        raw = _mm_add_epi32(raw, prev);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * g), raw);
+        prev = _mm_shuffle_epi32(raw, 0xFF);
+    }
+
+    uint32_t last = groups ? static_cast<uint32_t>(out[4 * groups - 1]) : 0;
+    decodeScalar(control, data, v, 4 * groups, degree, last, out);
+}
+
+bool hasSsse3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+#endif // COMPRESSEDGRAPH_SSSE3
+
+} // namespace
+
+CompressedGraph::CompressedGraph(const CsrGraph& graph)
+    : n_(graph.vertexCount()), m_(graph.edgeCount()) {
+    block_base_.reserve((static_cast<size_t>(n_) >> kBlockBits) + 1);
+    offsets_.reserve(n_);
+    vector<uint32_t> values;
+
+    for (int v = 0; v < n_; ++v) {
+        if ((v & ((1 << kBlockBits) - 1)) == 0) {
+            block_base_.push_back(data_.size());
+        }
+        uint64_t relative = data_.size() - block_base_.back();
+        if (relative > numeric_limits<uint32_t>::max()) {
+            cerr << "Слишком большой блок списков смежности у вершины " << v << endl;
+            exit(EXIT_FAILURE);
+        }
+        offsets_.push_back(static_cast<uint32_t>(relative));
+
+        size_t begin = graph.offsets[v];
+        int degree = static_cast<int>(graph.offsets[v + 1] - begin);
+        values.clear();
+        for (int i = 0; i < degree; ++i) {
+            int neighbor = graph.neighbors[begin + i];
+            values.push_back(i == 0
+                ? zigzag(static_cast<int64_t>(neighbor) - v)
+                : static_cast<uint32_t>(neighbor - graph.neighbors[begin + i - 1]));
+        }
+
+        writeVarint(data_, static_cast<uint32_t>(degree));
+        size_t control = data_.size();
+        data_.resize(control + (degree + 3) / 4, 0);
+        for (int i = 0; i < degree; ++i) {
+            int length = byteLength(values[i]);
+            data_[control + (i >> 2)] |= static_cast<uint8_t>((length - 1) << (2 * (i & 3)));
+            for (int b = 0; b < length; ++b) {
+                data_.push_back(static_cast<uint8_t>(values[i] >> (8 * b)));
+            }
+        }
+    }
+
+    data_.resize(data_.size() + kPadding, 0);
+    data_.shrink_to_fit();
+}
+
+int CompressedGraph::vertexCount() const {
+    return n_;
+}
+
+size_t CompressedGraph::edgeCount() const {
+    return m_;
+}
+
+size_t CompressedGraph::bytes() const {
+    return block_base_.capacity() * sizeof(uint64_t)
+        + offsets_.capacity() * sizeof(uint32_t)
+        + data_.capacity();
+}
+
+int CompressedGraph::degree(int v) const {
+    const uint8_t* p = listStart(v);
+    return static_cast<int>(readVarint(p));
+}
+
+void CompressedGraph::neighbors(int v, vector<int>& out) const {
+    const uint8_t* p = listStart(v);
+    int degree = static_cast<int>(readVarint(p));
+    const uint8_t* control = p;
+    const uint8_t* data = p + (degree + 3) / 4;
+    out.resize(degree);
+
+#ifdef COMPRESSEDGRAPH_SSSE3
+    if (hasSsse3()) {
+        decodeSsse3(control, data, v, degree, out.data());
+        return;
+    }
+#endif
+    decodeScalar(control, data, v, 0, degree, 0, out.data());
+}
+
+const uint8_t* CompressedGraph::listStart(int v) const {
+    return data_.data() + block_base_[v >> kBlockBits] + offsets_[v];
+}
+
+size_t csrBytes(const CsrGraph& graph) {
+    return graph.offsets.capacity() * sizeof(size_t) + graph.neighbors.capacity() * sizeof(int);
+}
+
+set<int> CompressedReachableCitiesFinder::operator()(const CompressedGraph& graph, int start, int L) const {
+    return bitmapToSet(reachableBitmap(graph, start, L));
+}
+
+vector<uint64_t> CompressedReachableCitiesFinder::reachableBitmap(const CompressedGraph& graph, int start, int L) const {
+    vector<uint64_t> visited((static_cast<size_t>(graph.vertexCount()) + 63) / 64, 0);
+    visited[start >> 6] |= uint64_t{1} << (start & 63);
+
+    vector<int> frontier{start};
+    vector<int> next;
+    vector<int> buffer;
+
+    for (int level = 0; level < L && !frontier.empty(); ++level) {
+        next.clear();
+        for (int city : frontier) {
+            graph.neighbors(city, buffer);
+            for (int neighbor : buffer) {
+                uint64_t mask = uint64_t{1} << (neighbor & 63);
+                if (!(visited[neighbor >> 6] & mask)) {
+                    visited[neighbor >> 6] |= mask;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    return visited;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file CompressedGraph.h
+ * @brief Сжатое хранение списков смежности (Stream VByte по разностям) и обход по сжатому графу
+ */
+
+#ifndef COMPRESSEDGRAPH_H
+#define COMPRESSEDGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Граф со сжатыми отсортированными списками соседей
+ *
+ * Список вершины v хранится как: степень (varint), управляющие байты Stream VByte
+ * (по 2 бита длины на число) и байты значений. Первое значение — zigzag-разность
+ * первого соседа и v, остальные — разности соседних элементов списка.
+ * Индекс смещений двухуровневый: 64-битная база на каждые 64 вершины и 32-битное
+ * смещение вершины внутри блока, поэтому доступ к списку любой вершины — O(1).
+ * Декодирование использует SSSE3 (pshufb), если процессор его поддерживает.
+ */
+class CompressedGraph {
+public:
+    CompressedGraph() = default;
+
+    /**
+     * @brief Сжимает граф
+     * @param graph Граф в формате CSR (списки соседей отсортированы)
+     */
+    explicit CompressedGraph(const CsrGraph& graph);
+
+    /**
+     * @brief Количество вершин
+     */
+    int vertexCount() const;
+
+    /**
+     * @brief Количество дуг
+     */
+    std::size_t edgeCount() const;
+
+    /**
+     * @brief Память, занятая сжатым представлением, в байтах
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Степень вершины
+     */
+    int degree(int v) const;
+
+    /**
+     * @brief Распаковывает отсортированный список соседей вершины
+     * @param v Вершина
+     * @param out Буфер для результата (перезаписывается)
+     */
+    void neighbors(int v, std::vector<int>& out) const;
+
+private:
+    const std::uint8_t* listStart(int v) const;
+
+    int n_ = 0;
+    std::size_t m_ = 0;
+    std::vector<std::uint64_t> block_base_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint8_t> data_;
+};
+
+/**
+ * @brief Память, занимаемая графом в формате CSR, в байтах
+ */
+std::size_t csrBytes(const CsrGraph& graph);
+
+/**
+ * @brief Функциональный объект для поиска достижимых городов прямо по сжатому графу
+ */
+class CompressedReachableCitiesFinder {
+public:
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     * @param graph Сжатый граф
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы)
+     */
+    std::set<int> operator()(const CompressedGraph& graph, int start, int L) const;
+
+    /**
+     * @brief То же, что operator(), но возвращает битовую карту посещённых вершин
+     */
+    std::vector<std::uint64_t> reachableBitmap(const CompressedGraph& graph, int start, int L) const;
+};
+
+#endif // COMPRESSEDGRAPH_H
@@ -0,0 +1,225 @@
+/**
+ * @file CsrGraph.cpp
+ * @brief Реализация CSR-графа и параллельного поуровневого обхода в ширину
+ */
+
+#include "CsrGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "BitUtils.h"
+
+using namespace std;
+
+namespace {
+
+// Размер порции фронта, которую поток забирает за один раз
+const size_t kChunkSize = 256;
+
+/**
+ * @brief Атомарно помечает вершину посещённой
+ * @return true, если вершину пометил именно этот вызов
+ */
+bool tryClaim(atomic<uint64_t>* visited, int v) {
+    uint64_t mask = uint64_t{1} << (v & 63);
+    atomic<uint64_t>& word = visited[v >> 6];
+    if (word.load(memory_order_relaxed) & mask) return false;
+    return !(word.fetch_or(mask, memory_order_relaxed) & mask);
+}
+
+void expandRange(const CsrGraph& graph, atomic<uint64_t>* visited,
+                 const vector<int>& frontier, size_t begin, size_t end, vector<int>& next) {
+    for (size_t i = begin; i < end; ++i) {
+        int city = frontier[i];
+        for (size_t e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+            int neighbor = graph.neighbors[e];
+            if (tryClaim(visited, neighbor)) {
+                next.push_back(neighbor);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int CsrGraph::vertexCount() const {
+    return offsets.empty() ? 0 : static_cast<int>(offsets.size() - 1);
+}
+
+size_t CsrGraph::edgeCount() const {
+    return neighbors.size();
+}
+
+CsrGraph buildCsr(const vector<vector<int>>& graph) {
+    CsrGraph csr;
+    csr.offsets.reserve(graph.size() + 1);
+    csr.offsets.push_back(0);
+
+    for (const auto& row : graph) {
+        for (int j = 0; j < static_cast<int>(row.size()); ++j) {
+            if (row[j]) csr.neighbors.push_back(j);
+        }
+        csr.offsets.push_back(csr.neighbors.size());
+    }
+
+    return csr;
+}
+
+CsrGraph readGraphCsr(const string& filename, int& n) {
+    ifstream file(filename);
+    if (!file) {
+        cerr << "Не удалось открыть файл: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    file >> n;
+    CsrGraph csr;
+    csr.offsets.reserve(static_cast<size_t>(n) + 1);
+    csr.offsets.push_back(0);
+
+    int val = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            file >> val;
+            if (val) csr.neighbors.push_back(j);
+        }
+        csr.offsets.push_back(csr.neighbors.size());
+    }
+
+    return csr;
+}
+
+void writeGraphBinary(const CsrGraph& graph, const string& filename) {
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "Не удалось открыть файл: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    uint64_t n = static_cast<uint64_t>(graph.vertexCount());
+    uint64_t m = graph.edgeCount();
+    vector<uint64_t> offsets(graph.offsets.begin(), graph.offsets.end());
+
+    file.write(kCsrBinaryMagic, sizeof(kCsrBinaryMagic));
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(reinterpret_cast<const char*>(&m), sizeof(m));
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(graph.neighbors.data()), m * sizeof(int));
+}
+
+CsrGraph readGraphBinary(const string& filename, int& n) {
+    ifstream file(filename, ios::binary);
+    char magic[sizeof(kCsrBinaryMagic)] = {};
+    uint64_t vertices = 0;
+    uint64_t edges = 0;
+    if (!file || !file.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), kCsrBinaryMagic)
+        || !file.read(reinterpret_cast<char*>(&vertices), sizeof(vertices))
+        || !file.read(reinterpret_cast<char*>(&edges), sizeof(edges))) {
+        cerr << "Не удалось прочитать граф из файла: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    CsrGraph csr;
+    vector<uint64_t> offsets(vertices + 1);
+    csr.neighbors.resize(edges);
+    if (!file.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint64_t))
+        || !file.read(reinterpret_cast<char*>(csr.neighbors.data()), edges * sizeof(int))) {
+        cerr << "Не удалось прочитать граф из файла: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+    csr.offsets.assign(offsets.begin(), offsets.end());
+
+    n = static_cast<int>(vertices);
+    return csr;
+}
+
+CsrGraph loadGraph(const string& filename, int& n) {
+    const string extension = ".csr";
+    if (filename.size() >= extension.size()
+        && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0) {
+        return readGraphBinary(filename, n);
+    }
+    return readGraphCsr(filename, n);
+}
+
+set<int> bitmapToSet(const vector<uint64_t>& bitmap) {
+    set<int> result;
+    for (size_t w = 0; w < bitmap.size(); ++w) {
+        uint64_t word = bitmap[w];
+        while (word) {
+            int bit = countTrailingZeros(word);
+            result.insert(result.end(), static_cast<int>(w * 64 + bit));
+            word &= word - 1;
+        }
+    }
+    return result;
+}
+
+ParallelReachableCitiesFinder::ParallelReachableCitiesFinder(unsigned threads, size_t sequential_threshold)
+    : threads_(threads ? threads : max(1u, thread::hardware_concurrency())),
+      sequential_threshold_(sequential_threshold) {}
+
+set<int> ParallelReachableCitiesFinder::operator()(const CsrGraph& graph, int start, int L) const {
+    return bitmapToSet(reachableBitmap(graph, start, L));
+}
+
+vector<uint64_t> ParallelReachableCitiesFinder::reachableBitmap(const CsrGraph& graph, int start, int L) const {
+    size_t words = (static_cast<size_t>(graph.vertexCount()) + 63) / 64;
+    unique_ptr<atomic<uint64_t>[]> visited(new atomic<uint64_t>[words]);
+    for (size_t w = 0; w < words; ++w) {
+        visited[w].store(0, memory_order_relaxed);
+    }
+
+    vector<int> frontier{start};
+    vector<int> next;
+    tryClaim(visited.get(), start);
+
+    for (int level = 0; level < L && !frontier.empty(); ++level) {
+        next.clear();
+
+        if (threads_ <= 1 || frontier.size() < sequential_threshold_) {
+            expandRange(graph, visited.get(), frontier, 0, frontier.size(), next);
+        } else {
+            atomic<size_t> cursor{0};
+            vector<vector<int>> local(threads_);
+
+            auto worker = [&](unsigned t) {
+                for (;;) {
+                    size_t begin = cursor.fetch_add(kChunkSize, memory_order_relaxed);
+                    if (begin >= frontier.size()) break;
+                    size_t end = min(begin + kChunkSize, frontier.size());
+                    expandRange(graph, visited.get(), frontier, begin, end, local[t]);
+                }
+            };
+
+            vector<thread> pool;
+            pool.reserve(threads_ - 1);
+            for (unsigned t = 1; t < threads_; ++t) {
+                pool.emplace_back(worker, t);
+            }
+            worker(0);
+            for (auto& th : pool) th.join();
+
+            // Граница уровня: сливаем локальные буферы в общий фронт
+            size_t total = 0;
+            for (const auto& part : local) total += part.size();
+            next.reserve(total);
+            for (const auto& part : local) {
+                next.insert(next.end(), part.begin(), part.end());
+            }
+        }
+
+        frontier.swap(next);
+    }
+
+    vector<uint64_t> result(words);
+    for (size_t w = 0; w < words; ++w) {
+        result[w] = visited[w].load(memory_order_relaxed);
+    }
+    return result;
+}
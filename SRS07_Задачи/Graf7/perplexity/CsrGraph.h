@@ -0,0 +1,130 @@
+/**
+ * @file CsrGraph.h
+ * @brief Компактное представление графа (CSR) и параллельный поиск достижимых городов
+ */
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Граф в формате CSR (compressed sparse row)
+ *
+ * Соседи вершины v занимают отрезок neighbors[offsets[v], offsets[v + 1])
+ * и отсортированы по возрастанию.
+ */
+struct CsrGraph {
+    std::vector<std::size_t> offsets;
+    std::vector<int> neighbors;
+
+    /**
+     * @brief Возвращает количество вершин
+     */
+    int vertexCount() const;
+
+    /**
+     * @brief Возвращает количество дуг
+     */
+    std::size_t edgeCount() const;
+};
+
+/**
+ * @brief Строит CSR-представление по матрице смежности
+ * @param graph Матрица смежности
+ * @return Граф в формате CSR
+ */
+CsrGraph buildCsr(const std::vector<std::vector<int>>& graph);
+
+/**
+ * @brief Читает матрицу смежности из файла сразу в CSR, не храня матрицу целиком
+ * @param filename Имя файла
+ * @param n Количество городов (выходной параметр)
+ * @return Граф в формате CSR
+ */
+CsrGraph readGraphCsr(const std::string& filename, int& n);
+
+/// Сигнатура в начале двоичного CSR-файла
+inline constexpr char kCsrBinaryMagic[4] = {'C', 'S', 'R', '1'};
+
+/// Размер заголовка двоичного CSR-файла: сигнатура, n и m (uint64); смещения идут следом
+inline constexpr std::uint64_t kCsrHeaderSize = sizeof(kCsrBinaryMagic) + 2 * sizeof(std::uint64_t);
+
+/**
+ * @brief Записывает граф в двоичный CSR-файл
+ *
+ * Формат: сигнатура "CSR1", число вершин n и дуг m (uint64), затем n + 1 смещений
+ * (uint64) и m номеров соседей (int32) в порядке байтов машины.
+ * @param graph Граф в формате CSR
+ * @param filename Имя файла
+ */
+void writeGraphBinary(const CsrGraph& graph, const std::string& filename);
+
+/**
+ * @brief Читает граф из двоичного CSR-файла
+ * @param filename Имя файла
+ * @param n Количество городов (выходной параметр)
+ * @return Граф в формате CSR
+ */
+CsrGraph readGraphBinary(const std::string& filename, int& n);
+
+/**
+ * @brief Читает граф, выбирая формат по расширению: ".csr" — двоичный CSR, иначе матрица смежности
+ * @param filename Имя файла
+ * @param n Количество городов (выходной параметр)
+ * @return Граф в формате CSR
+ */
+CsrGraph loadGraph(const std::string& filename, int& n);
+
+/**
+ * @brief Преобразует битовую карту посещённых вершин в множество
+ * @param bitmap Битовая карта (бит v установлен, если вершина v посещена)
+ * @return Множество вершин (0-based индексы)
+ */
+std::set<int> bitmapToSet(const std::vector<std::uint64_t>& bitmap);
+
+/**
+ * @brief Параллельный поуровневый поиск достижимых городов
+ *
+ * Каждый фронт делится между потоками; вершины захватываются атомарным
+ * fetch_or в битовой карте посещённых, следующий фронт собирается в локальных
+ * буферах потоков и сливается на границе уровня. Небольшие фронты
+ * обрабатываются последовательно, без запуска потоков.
+ */
+class ParallelReachableCitiesFinder {
+public:
+    /**
+     * @brief Конструктор
+     * @param threads Число потоков (0 — по числу ядер)
+     * @param sequential_threshold Размер фронта, ниже которого уровень обходится в одном потоке
+     */
+    explicit ParallelReachableCitiesFinder(unsigned threads = 0, std::size_t sequential_threshold = 4096);
+
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     * @param graph Граф в формате CSR
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы)
+     */
+    std::set<int> operator()(const CsrGraph& graph, int start, int L) const;
+
+    /**
+     * @brief То же, что operator(), но возвращает битовую карту посещённых вершин
+     * @param graph Граф в формате CSR
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Битовая карта из (n + 63) / 64 слов
+     */
+    std::vector<std::uint64_t> reachableBitmap(const CsrGraph& graph, int start, int L) const;
+
+private:
+    unsigned threads_;
+    std::size_t sequential_threshold_;
+};
+
+#endif // CSRGRAPH_H
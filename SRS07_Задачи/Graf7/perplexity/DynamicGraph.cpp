@@ -0,0 +1,334 @@
+/**
+ * @file DynamicGraph.cpp
+ * @brief Реализация изменяемого графа с инкрементальным обновлением множеств достижимости
+ */
+
+#include "DynamicGraph.h"
+#include <algorithm>
+#include <atomic>
+#include <queue>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+
+bool isValidCity(int v, int n) {
+    return v >= 0 && v < n;
+}
+
+HotBall computeBall(const RowTable& out, int start, int L) {
+    HotBall ball;
+    ball.limit = L;
+    ball.dist[start] = 0;
+
+    queue<int> q;
+    q.push(start);
+    while (!q.empty()) {
+        int city = q.front();
+        q.pop();
+
+        int level = ball.dist[city];
+        if (level >= L) continue;
+
+        for (int neighbor : out.row(city)) {
+            if (ball.dist.emplace(neighbor, level + 1).second) {
+                q.push(neighbor);
+            }
+        }
+    }
+
+    return ball;
+}
+
+bool needsGrowth(const HotBall& ball, int from, int to) {
+    auto from_it = ball.dist.find(from);
+    if (from_it == ball.dist.end() || from_it->second >= ball.limit) return false;
+    auto to_it = ball.dist.find(to);
+    return to_it == ball.dist.end() || to_it->second > from_it->second + 1;
+}
+
+/**
+ * @brief Расширяет шар после добавления дуги from -> to
+ */
+void growBall(const RowTable& out, HotBall& ball, int from, int to) {
+    ball.dist[to] = ball.dist[from] + 1;
+
+    queue<int> q;
+    q.push(to);
+    while (!q.empty()) {
+        int city = q.front();
+        q.pop();
+
+        int level = ball.dist[city];
+        if (level >= ball.limit) continue;
+
+        for (int neighbor : out.row(city)) {
+            auto it = ball.dist.find(neighbor);
+            if (it == ball.dist.end() || it->second > level + 1) {
+                ball.dist[neighbor] = level + 1;
+                q.push(neighbor);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Проверяет, есть ли у вершины родитель на предыдущем уровне вне множества excluded
+ */
+bool hasTightParent(const RowTable& in, const HotBall& ball, int v, int level,
+                    const unordered_set<int>& excluded) {
+    for (int parent : in.row(v)) {
+        auto it = ball.dist.find(parent);
+        if (it != ball.dist.end() && it->second == level - 1 && !excluded.count(parent)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool needsRepair(const RowTable& in, const HotBall& ball, int from, int to) {
+    auto from_it = ball.dist.find(from);
+    auto to_it = ball.dist.find(to);
+    if (from_it == ball.dist.end() || to_it == ball.dist.end()) return false;
+    if (to_it->second != from_it->second + 1) return false;
+    return !hasTightParent(in, ball, to, to_it->second, {});
+}
+
+/**
+ * @brief Восстанавливает шар после удаления дуги в вершину to, оставшуюся без родителя
+ *
+ * Сначала собирается затронутая область — вершины, все кратчайшие пути к которым
+ * шли через to, затем расстояния в ней пересчитываются от границы с остальным шаром.
+ */
+void repairBall(const RowTable& out, const RowTable& in, HotBall& ball, int to) {
+    unordered_set<int> affected;
+    unordered_set<int> seen{to};
+    queue<int> q;
+    q.push(to);
+
+    // Очередь упорядочена по уровням, поэтому к моменту решения о вершине
+    // все её родители уже классифицированы
+    while (!q.empty()) {
+        int city = q.front();
+        q.pop();
+
+        int level = ball.dist[city];
+        if (city != to && hasTightParent(in, ball, city, level, affected)) continue;
+        affected.insert(city);
+
+        for (int neighbor : out.row(city)) {
+            auto it = ball.dist.find(neighbor);
+            if (it != ball.dist.end() && it->second == level + 1 && seen.insert(neighbor).second) {
+                q.push(neighbor);
+            }
+        }
+    }
+
+    for (int city : affected) {
+        ball.dist.erase(city);
+    }
+
+    vector<vector<int>> buckets(ball.limit + 1);
+    unordered_map<int, int> tentative;
+    for (int city : affected) {
+        int best = ball.limit + 1;
+        for (int parent : in.row(city)) {
+            auto it = ball.dist.find(parent);
+            if (it != ball.dist.end()) best = min(best, it->second + 1);
+        }
+        if (best <= ball.limit) {
+            tentative[city] = best;
+            buckets[best].push_back(city);
+        }
+    }
+
+    for (int level = 0; level <= ball.limit; ++level) {
+        for (size_t i = 0; i < buckets[level].size(); ++i) {
+            int city = buckets[level][i];
+            if (tentative[city] != level || ball.dist.count(city)) continue;
+            ball.dist[city] = level;
+            if (level == ball.limit) continue;
+
+            for (int neighbor : out.row(city)) {
+                if (!affected.count(neighbor) || ball.dist.count(neighbor)) continue;
+                auto it = tentative.find(neighbor);
+                if (it == tentative.end() || it->second > level + 1) {
+                    tentative[neighbor] = level + 1;
+                    buckets[level + 1].push_back(neighbor);
+                }
+            }
+        }
+    }
+}
+
+bool insertSorted(RowTable::Row& row, int value) {
+    auto it = lower_bound(row.begin(), row.end(), value);
+    if (it != row.end() && *it == value) return false;
+    row.insert(it, value);
+    return true;
+}
+
+bool eraseSorted(RowTable::Row& row, int value) {
+    auto it = lower_bound(row.begin(), row.end(), value);
+    if (it == row.end() || *it != value) return false;
+    row.erase(it);
+    return true;
+}
+
+} // namespace
+
+RowTable::RowTable(int n) {
+    int page_size = 1 << kPageBits;
+    int pages = (n + page_size - 1) / page_size;
+    pages_.reserve(pages);
+    for (int p = 0; p < pages; ++p) {
+        auto page = make_shared<Page>(page_size);
+        for (auto& row : *page) row = make_shared<Row>();
+        pages_.push_back(page);
+    }
+}
+
+const RowTable::Row& RowTable::row(int v) const {
+    return *(*pages_[v >> kPageBits])[v & ((1 << kPageBits) - 1)];
+}
+
+RowTable::Row& RowTable::mutableRow(int v) {
+    // Страница или строка с единственным владельцем недоступна читателям,
+    // её можно менять на месте
+    auto& page = pages_[v >> kPageBits];
+    if (page.use_count() > 1) page = make_shared<Page>(*page);
+    auto& row = (*page)[v & ((1 << kPageBits) - 1)];
+    if (row.use_count() > 1) row = make_shared<Row>(*row);
+    return *row;
+}
+
+uint64_t GraphSnapshot::epoch() const {
+    return epoch_;
+}
+
+int GraphSnapshot::vertexCount() const {
+    return n_;
+}
+
+bool GraphSnapshot::hasEdge(int from, int to) const {
+    if (!isValidCity(from, n_) || !isValidCity(to, n_)) return false;
+    const auto& row = out_.row(from);
+    return binary_search(row.begin(), row.end(), to);
+}
+
+set<int> GraphSnapshot::reachable(int start, int L) const {
+    set<int> result;
+    auto it = balls_.find(start);
+    if (it != balls_.end() && it->second->limit >= L) {
+        for (const auto& [city, level] : it->second->dist) {
+            if (level <= L) result.insert(city);
+        }
+        return result;
+    }
+
+    for (const auto& entry : computeBall(out_, start, L).dist) {
+        result.insert(entry.first);
+    }
+    return result;
+}
+
+DynamicGraph::DynamicGraph(const CsrGraph& graph) {
+    auto snap = make_shared<GraphSnapshot>();
+    snap->n_ = graph.vertexCount();
+    snap->out_ = RowTable(snap->n_);
+    snap->in_ = RowTable(snap->n_);
+
+    for (int v = 0; v < snap->n_; ++v) {
+        auto& row = snap->out_.mutableRow(v);
+        row.assign(graph.neighbors.begin() + graph.offsets[v], graph.neighbors.begin() + graph.offsets[v + 1]);
+        for (int neighbor : row) {
+            snap->in_.mutableRow(neighbor).push_back(v);
+        }
+    }
+
+    current_ = snap;
+}
+
+shared_ptr<const GraphSnapshot> DynamicGraph::snapshot() const {
+    return atomic_load(&current_);
+}
+
+void DynamicGraph::addEdge(int from, int to) {
+    applyUpdates({{from, to, true}});
+}
+
+void DynamicGraph::removeEdge(int from, int to) {
+    applyUpdates({{from, to, false}});
+}
+
+void DynamicGraph::applyUpdates(const vector<EdgeUpdate>& updates) {
+    lock_guard<mutex> lock(write_mutex_);
+    auto next = make_shared<GraphSnapshot>(*current_);
+    ++next->epoch_;
+
+    // Шары, уже скопированные в этой пачке, меняются на месте
+    map<int, shared_ptr<HotBall>> owned;
+    auto ownBall = [&](int start) -> HotBall& {
+        auto& ball = owned[start];
+        if (!ball) {
+            ball = make_shared<HotBall>(*next->balls_[start]);
+            next->balls_[start] = ball;
+        }
+        return *ball;
+    };
+
+    for (const auto& update : updates) {
+        if (!isValidCity(update.from, next->n_) || !isValidCity(update.to, next->n_)) continue;
+
+        if (update.insert) {
+            if (!insertSorted(next->out_.mutableRow(update.from), update.to)) continue;
+            insertSorted(next->in_.mutableRow(update.to), update.from);
+
+            for (const auto& [start, ball] : next->balls_) {
+                if (needsGrowth(*ball, update.from, update.to)) {
+                    growBall(next->out_, ownBall(start), update.from, update.to);
+                }
+            }
+        } else {
+            if (!eraseSorted(next->out_.mutableRow(update.from), update.to)) continue;
+            eraseSorted(next->in_.mutableRow(update.to), update.from);
+
+            for (const auto& [start, ball] : next->balls_) {
+                if (needsRepair(next->in_, *ball, update.from, update.to)) {
+                    repairBall(next->out_, next->in_, ownBall(start), update.to);
+                }
+            }
+        }
+    }
+
+    publish(next);
+}
+
+void DynamicGraph::trackCity(int start, int L) {
+    lock_guard<mutex> lock(write_mutex_);
+    if (!isValidCity(start, current_->n_)) return;
+    // Как и при поиске, отрицательное L означает только сам город; предел шара не бывает меньше 0
+    L = max(L, 0);
+
+    auto next = make_shared<GraphSnapshot>(*current_);
+    ++next->epoch_;
+    next->balls_[start] = make_shared<HotBall>(computeBall(next->out_, start, L));
+    publish(next);
+}
+
+void DynamicGraph::untrackCity(int start) {
+    lock_guard<mutex> lock(write_mutex_);
+    auto next = make_shared<GraphSnapshot>(*current_);
+    ++next->epoch_;
+    next->balls_.erase(start);
+    publish(next);
+}
+
+set<int> DynamicGraph::reachable(int start, int L) const {
+    return snapshot()->reachable(start, L);
+}
+
+void DynamicGraph::publish(shared_ptr<GraphSnapshot> next) {
+    atomic_store(&current_, shared_ptr<const GraphSnapshot>(move(next)));
+}
@@ -0,0 +1,171 @@
+/**
+ * @file DynamicGraph.h
+ * @brief Изменяемый граф с поддержкой кэшированных множеств достижимости и чтением по снимкам
+ */
+
+#ifndef DYNAMICGRAPH_H
+#define DYNAMICGRAPH_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Изменение графа: добавление или удаление дуги
+ */
+struct EdgeUpdate {
+    int from;
+    int to;
+    bool insert;
+};
+
+/**
+ * @brief Таблица списков соседей с копированием при записи
+ *
+ * Строки сгруппированы в страницы; копия таблицы разделяет страницы
+ * с оригиналом, а изменение строки копирует только её страницу и её саму.
+ */
+class RowTable {
+public:
+    using Row = std::vector<int>;
+
+    RowTable() = default;
+
+    /**
+     * @brief Создаёт таблицу из n пустых строк
+     */
+    explicit RowTable(int n);
+
+    /**
+     * @brief Возвращает отсортированный список соседей вершины
+     */
+    const Row& row(int v) const;
+
+    /**
+     * @brief Возвращает строку для изменения, при необходимости отделяя её от других копий
+     */
+    Row& mutableRow(int v);
+
+private:
+    static const int kPageBits = 8;
+    using Page = std::vector<std::shared_ptr<Row>>;
+    std::vector<std::shared_ptr<Page>> pages_;
+};
+
+/**
+ * @brief Поддерживаемое множество достижимости горячего города: расстояния не больше limit
+ */
+struct HotBall {
+    int limit = 0;
+    std::unordered_map<int, int> dist;
+};
+
+/**
+ * @brief Неизменяемый снимок графа в конкретную эпоху
+ */
+class GraphSnapshot {
+public:
+    /**
+     * @brief Номер эпохи снимка (увеличивается при каждой пачке изменений)
+     */
+    std::uint64_t epoch() const;
+
+    /**
+     * @brief Количество вершин
+     */
+    int vertexCount() const;
+
+    /**
+     * @brief Проверяет наличие дуги
+     */
+    bool hasEdge(int from, int to) const;
+
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     *
+     * Если start отслеживается с пределом не меньше L, ответ берётся из кэша,
+     * иначе выполняется обход в ширину по этому снимку.
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы)
+     */
+    std::set<int> reachable(int start, int L) const;
+
+private:
+    friend class DynamicGraph;
+
+    std::uint64_t epoch_ = 0;
+    int n_ = 0;
+    RowTable out_;
+    RowTable in_;
+    std::map<int, std::shared_ptr<const HotBall>> balls_;
+};
+
+/**
+ * @brief Граф, допускающий добавление и удаление дуг во время выполнения запросов
+ *
+ * Читатели получают снимок через snapshot() и работают с ним без блокировок;
+ * писатели готовят новую версию и публикуют её атомарно. Множества достижимости
+ * отслеживаемых городов обновляются инкрементально: при добавлении дуги шары
+ * расширяются, при удалении пересчитывается только затронутая область.
+ */
+class DynamicGraph {
+public:
+    /**
+     * @brief Конструктор
+     * @param graph Исходный граф в формате CSR
+     */
+    explicit DynamicGraph(const CsrGraph& graph);
+
+    /**
+     * @brief Возвращает текущий снимок графа
+     */
+    std::shared_ptr<const GraphSnapshot> snapshot() const;
+
+    /**
+     * @brief Добавляет дугу from -> to (0-based индексы)
+     */
+    void addEdge(int from, int to);
+
+    /**
+     * @brief Удаляет дугу from -> to (0-based индексы)
+     */
+    void removeEdge(int from, int to);
+
+    /**
+     * @brief Применяет пачку изменений и публикует один новый снимок
+     * @param updates Изменения в порядке применения
+     */
+    void applyUpdates(const std::vector<EdgeUpdate>& updates);
+
+    /**
+     * @brief Начинает отслеживать множество достижимости города
+     * @param start Город (0-based индекс)
+     * @param L Максимальное число пересадок, для которого поддерживается кэш (отрицательное — как 0)
+     */
+    void trackCity(int start, int L);
+
+    /**
+     * @brief Прекращает отслеживать город
+     */
+    void untrackCity(int start);
+
+    /**
+     * @brief Находит достижимые города по текущему снимку
+     */
+    std::set<int> reachable(int start, int L) const;
+
+private:
+    void publish(std::shared_ptr<GraphSnapshot> next);
+
+    std::shared_ptr<const GraphSnapshot> current_;
+    std::mutex write_mutex_;
+};
+
+#endif // DYNAMICGRAPH_H
@@ -0,0 +1,143 @@
+/**
+ * @file ExternalGraph.cpp
+ * @brief Реализация графа на диске и обхода во внешней памяти
+ */
+
+#include "ExternalGraph.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CsrGraph.h"
+
+using namespace std;
+
+ExternalGraph::ExternalGraph(const string& filename) : filename_(filename) {
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        cerr << "Не удалось открыть файл: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    char header[kCsrHeaderSize];
+    readAt(0, header, sizeof(header));
+    if (memcmp(header, kCsrBinaryMagic, sizeof(kCsrBinaryMagic)) != 0) {
+        cerr << "Файл не является двоичным CSR-графом: " << filename << endl;
+        exit(EXIT_FAILURE);
+    }
+
+    uint64_t vertices = 0;
+    memcpy(&vertices, header + sizeof(kCsrBinaryMagic), sizeof(vertices));
+    memcpy(&m_, header + sizeof(kCsrBinaryMagic) + sizeof(vertices), sizeof(m_));
+    n_ = static_cast<int>(vertices);
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+ExternalGraph::~ExternalGraph() {
+    if (fd_ >= 0) close(fd_);
+}
+
+int ExternalGraph::vertexCount() const {
+    return n_;
+}
+
+uint64_t ExternalGraph::edgeCount() const {
+    return m_;
+}
+
+uint64_t ExternalGraph::offsetPosition(int v) const {
+    return kCsrHeaderSize + static_cast<uint64_t>(v) * sizeof(uint64_t);
+}
+
+uint64_t ExternalGraph::neighborPosition(uint64_t e) const {
+    return offsetPosition(n_ + 1) + e * sizeof(int);
+}
+
+const ExternalIoStats& ExternalGraph::stats() const {
+    return stats_;
+}
+
+void ExternalGraph::readAt(uint64_t position, char* data, size_t length) const {
+    ++stats_.read_calls;
+    while (length > 0) {
+        ssize_t got = pread(fd_, data, length, static_cast<off_t>(position));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {
+            cerr << "Ошибка чтения файла: " << filename_ << endl;
+            exit(EXIT_FAILURE);
+        }
+        stats_.bytes_read += static_cast<uint64_t>(got);
+        data += got;
+        position += static_cast<uint64_t>(got);
+        length -= static_cast<size_t>(got);
+    }
+}
+
+ExternalReachableCitiesFinder::ExternalReachableCitiesFinder(size_t buffer_bytes)
+    : buffer_bytes_(buffer_bytes) {}
+
+set<int> ExternalReachableCitiesFinder::operator()(const ExternalGraph& graph, int start, int L) const {
+    // Размер буфера кратен 8, чтобы части длинных списков не разрезали номера соседей
+    vector<char> buffer(max<size_t>(buffer_bytes_, 4096) & ~size_t{7});
+    size_t batch = buffer.size() / (2 * sizeof(uint64_t));
+
+    vector<uint64_t> visited((static_cast<size_t>(graph.vertexCount()) + 63) / 64, 0);
+    visited[start >> 6] |= uint64_t{1} << (start & 63);
+
+    vector<int> frontier{start};
+    vector<int> next;
+    vector<ExternalGraph::Range> ranges;
+    vector<ExternalGraph::Range> lists;
+
+    for (int level = 0; level < L && !frontier.empty(); ++level) {
+        next.clear();
+
+        for (size_t from = 0; from < frontier.size(); from += batch) {
+            size_t to = min(frontier.size(), from + batch);
+
+            // Смещения offsets[v], offsets[v + 1] для отсортированной части фронта
+            ranges.clear();
+            for (size_t i = from; i < to; ++i) {
+                uint64_t position = graph.offsetPosition(frontier[i]);
+                ranges.push_back({position, position + 2 * sizeof(uint64_t)});
+            }
+            lists.resize(to - from);
+            graph.readRanges(ranges, buffer, [&](size_t i, const char* data, size_t) {
+                memcpy(&lists[i].begin, data, sizeof(uint64_t));
+                memcpy(&lists[i].end, data + sizeof(uint64_t), sizeof(uint64_t));
+            });
+
+            // Списки соседей лежат в файле в том же порядке, что и вершины фронта
+            ranges.clear();
+            for (const auto& list : lists) {
+                if (list.begin < list.end) {
+                    ranges.push_back({graph.neighborPosition(list.begin), graph.neighborPosition(list.end)});
+                }
+            }
+            graph.readRanges(ranges, buffer, [&](size_t, const char* data, size_t length) {
+                for (size_t k = 0; k < length; k += sizeof(int)) {
+                    int neighbor;
+                    memcpy(&neighbor, data + k, sizeof(int));
+                    uint64_t mask = uint64_t{1} << (neighbor & 63);
+                    if (!(visited[neighbor >> 6] & mask)) {
+                        visited[neighbor >> 6] |= mask;
+                        next.push_back(neighbor);
+                    }
+                }
+            });
+        }
+
+        // Отсортированный фронт даёт последовательный доступ к файлу на следующем уровне
+        sort(next.begin(), next.end());
+        frontier.swap(next);
+    }
+
+    return bitmapToSet(visited);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ExternalGraph.h
+ * @brief Граф на диске и поиск достижимых городов во внешней памяти
+ */
+
+#ifndef EXTERNALGRAPH_H
+#define EXTERNALGRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Счётчики ввода-вывода внешнего обхода
+ */
+struct ExternalIoStats {
+    std::uint64_t bytes_read = 0;
+    std::uint64_t read_calls = 0;
+};
+
+/**
+ * @brief Граф в двоичном CSR-файле (см. writeGraphBinary), который читается с диска по мере надобности
+ *
+ * В памяти хранится только заголовок; смещения и списки соседей читаются
+ * крупными последовательными pread по отсортированным запросам. Класс не потокобезопасен.
+ */
+class ExternalGraph {
+public:
+    /**
+     * @brief Байтовый отрезок файла [begin, end)
+     */
+    struct Range {
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+
+    /**
+     * @brief Открывает файл графа
+     * @param filename Имя файла в формате writeGraphBinary
+     */
+    explicit ExternalGraph(const std::string& filename);
+    ~ExternalGraph();
+
+    ExternalGraph(const ExternalGraph&) = delete;
+    ExternalGraph& operator=(const ExternalGraph&) = delete;
+
+    /**
+     * @brief Количество вершин
+     */
+    int vertexCount() const;
+
+    /**
+     * @brief Количество дуг
+     */
+    std::uint64_t edgeCount() const;
+
+    /**
+     * @brief Положение в файле смещения offsets[v]
+     */
+    std::uint64_t offsetPosition(int v) const;
+
+    /**
+     * @brief Положение в файле элемента neighbors[e]
+     */
+    std::uint64_t neighborPosition(std::uint64_t e) const;
+
+    /**
+     * @brief Читает отсортированные по началу отрезки, объединяя близкие в одно чтение
+     *
+     * Для каждого отрезка i вызывается visit(i, data, length), возможно несколько раз
+     * подряд частями, если отрезок не помещается в буфер.
+     * @param ranges Отрезки, отсортированные по begin
+     * @param buffer Буфер чтения (его размер ограничивает одно чтение)
+     * @param visit Обработчик данных
+     */
+    template <typename Visit>
+    void readRanges(const std::vector<Range>& ranges, std::vector<char>& buffer, Visit visit) const;
+
+    /**
+     * @brief Счётчики ввода-вывода с момента открытия
+     */
+    const ExternalIoStats& stats() const;
+
+private:
+    void readAt(std::uint64_t position, char* data, std::size_t length) const;
+
+    int fd_ = -1;
+    std::string filename_;
+    int n_ = 0;
+    std::uint64_t m_ = 0;
+    mutable ExternalIoStats stats_;
+};
+
+/**
+ * @brief Функциональный объект для поиска достижимых городов по графу на диске
+ *
+ * Обход идёт поуровнево: фронт сортируется, по нему читаются нужные смещения
+ * и списки соседей, близкие отрезки склеиваются в крупные последовательные чтения.
+ * В памяти находятся битовая карта посещённых (n / 8 байт), текущий и следующий
+ * фронты и буфер чтения, размер которого задаётся бюджетом.
+ */
+class ExternalReachableCitiesFinder {
+public:
+    /**
+     * @brief Конструктор
+     * @param buffer_bytes Бюджет памяти на буфер чтения
+     */
+    explicit ExternalReachableCitiesFinder(std::size_t buffer_bytes = std::size_t{64} << 20);
+
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     * @param graph Граф на диске
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы)
+     */
+    std::set<int> operator()(const ExternalGraph& graph, int start, int L) const;
+
+private:
+    std::size_t buffer_bytes_;
+};
+
+template <typename Visit>
+void ExternalGraph::readRanges(const std::vector<Range>& ranges, std::vector<char>& buffer, Visit visit) const {
+    // Промежуток, который выгоднее прочитать, чем делать отдельный вызов
+    const std::uint64_t max_gap = 64 * 1024;
+    const std::uint64_t capacity = buffer.size();
+
+    std::size_t i = 0;
+    while (i < ranges.size()) {
+        const Range& first = ranges[i];
+
+        if (first.end - first.begin > capacity) {
+            for (std::uint64_t pos = first.begin; pos < first.end; pos += capacity) {
+                std::size_t length = static_cast<std::size_t>(std::min(capacity, first.end - pos));
+                readAt(pos, buffer.data(), length);
+                visit(i, buffer.data(), length);
+            }
+            ++i;
+            continue;
+        }
+
+        std::uint64_t group_end = first.end;
+        std::size_t j = i + 1;
+        while (j < ranges.size()
+               && ranges[j].begin <= group_end + max_gap
+               && std::max(group_end, ranges[j].end) - first.begin <= capacity) {
+            group_end = std::max(group_end, ranges[j].end);
+            ++j;
+        }
+
+        readAt(first.begin, buffer.data(), static_cast<std::size_t>(group_end - first.begin));
+        for (std::size_t k = i; k < j; ++k) {
+            visit(k, buffer.data() + (ranges[k].begin - first.begin),
+                  static_cast<std::size_t>(ranges[k].end - ranges[k].begin));
+        }
+        i = j;
+    }
+}
+
+#endif // EXTERNALGRAPH_H
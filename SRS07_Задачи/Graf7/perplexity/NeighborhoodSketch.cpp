@@ -0,0 +1,144 @@
+/**
+ * @file NeighborhoodSketch.cpp
+ * @brief Реализация счётчиков HyperLogLog для окрестностей вершин
+ */
+
+#include "NeighborhoodSketch.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "BitUtils.h"
+
+using namespace std;
+
+namespace {
+
+// Вершин в одной порции параллельного шага
+const int kChunkSize = 1024;
+
+/**
+ * @brief Выполняет body(begin, end) по порциям вершин [0, n) в нескольких потоках
+ */
+template <typename Body>
+void parallelFor(int n, unsigned threads, Body body) {
+    atomic<int> cursor{0};
+    auto worker = [&] {
+        for (;;) {
+            int begin = cursor.fetch_add(kChunkSize, memory_order_relaxed);
+            if (begin >= n) break;
+            body(begin, min(n, begin + kChunkSize));
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+} // namespace
+
+NeighborhoodSketches::NeighborhoodSketches(const CsrGraph& graph, int L, int precision, unsigned threads)
+    : n_(graph.vertexCount()),
+      precision_(min(16, max(4, precision))),
+      registers_per_vertex_(size_t{1} << precision_) {
+    if (!threads) threads = max(1u, thread::hardware_concurrency());
+    registers_.assign(static_cast<size_t>(n_) * registers_per_vertex_, 0);
+
+    // Шаг 0: каждая вершина достигает только саму себя
+    for (int v = 0; v < n_; ++v) {
+        uint64_t hash = mixHash(static_cast<uint64_t>(v));
+        size_t index = static_cast<size_t>(hash >> (64 - precision_));
+        uint64_t rest = hash << precision_;
+        int rank = min(leadingZeros(rest), 64 - precision_) + 1;
+        registers_[v * registers_per_vertex_ + index] = static_cast<uint8_t>(rank);
+    }
+
+    vector<uint8_t> next(registers_.size());
+    for (levels_ = 0; levels_ < L; ++levels_) {
+        atomic<bool> changed{false};
+
+        parallelFor(n_, threads, [&](int begin, int end) {
+            bool local_changed = false;
+            for (int v = begin; v < end; ++v) {
+                uint8_t* out = &next[v * registers_per_vertex_];
+                const uint8_t* own = &registers_[v * registers_per_vertex_];
+                copy(own, own + registers_per_vertex_, out);
+
+                for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                    const uint8_t* other = &registers_[graph.neighbors[e] * registers_per_vertex_];
+                    for (size_t j = 0; j < registers_per_vertex_; ++j) {
+                        out[j] = max(out[j], other[j]);
+                    }
+                }
+                local_changed = local_changed || !equal(own, own + registers_per_vertex_, out);
+            }
+            if (local_changed) changed.store(true, memory_order_relaxed);
+        });
+
+        registers_.swap(next);
+        if (!changed.load()) {
+            ++levels_;
+            break;
+        }
+    }
+}
+
+int NeighborhoodSketches::levels() const {
+    return levels_;
+}
+
+double NeighborhoodSketches::reachableCount(int v) const {
+    return estimate(sketch(v));
+}
+
+vector<double> NeighborhoodSketches::reachableCounts() const {
+    vector<double> counts(n_);
+    for (int v = 0; v < n_; ++v) counts[v] = reachableCount(v);
+    return counts;
+}
+
+double NeighborhoodSketches::unionCount(int a, int b) const {
+    vector<uint8_t> merged(sketch(a), sketch(a) + registers_per_vertex_);
+    const uint8_t* other = sketch(b);
+    for (size_t j = 0; j < registers_per_vertex_; ++j) {
+        merged[j] = max(merged[j], other[j]);
+    }
+    return estimate(merged.data());
+}
+
+double NeighborhoodSketches::commonCount(int a, int b) const {
+    return max(0.0, reachableCount(a) + reachableCount(b) - unionCount(a, b));
+}
+
+size_t NeighborhoodSketches::bytes() const {
+    return registers_.capacity();
+}
+
+const uint8_t* NeighborhoodSketches::sketch(int v) const {
+    return &registers_[v * registers_per_vertex_];
+}
+
+double NeighborhoodSketches::estimate(const uint8_t* registers) const {
+    double m = static_cast<double>(registers_per_vertex_);
+    double alpha = registers_per_vertex_ == 16 ? 0.673
+                 : registers_per_vertex_ == 32 ? 0.697
+                 : registers_per_vertex_ == 64 ? 0.709
+                 : 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0.0;
+    int zeros = 0;
+    for (size_t j = 0; j < registers_per_vertex_; ++j) {
+        sum += ldexp(1.0, -registers[j]);
+        zeros += registers[j] == 0;
+    }
+
+    double raw = alpha * m * m / sum;
+    // Поправка для малых множеств: линейный подсчёт по пустым регистрам
+    if (raw <= 2.5 * m && zeros > 0) {
+        return m * log(m / zeros);
+    }
+    return raw;
+}
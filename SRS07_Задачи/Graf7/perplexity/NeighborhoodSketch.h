@@ -0,0 +1,75 @@
+/**
+ * @file NeighborhoodSketch.h
+ * @brief Приближённые размеры и пересечения L-окрестностей всех вершин (HyperANF)
+ */
+
+#ifndef NEIGHBORHOODSKETCH_H
+#define NEIGHBORHOODSKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Счётчики HyperLogLog для множеств городов, достижимых из каждой вершины
+ *
+ * Счётчик вершины v на шаге t+1 — объединение (поразрядный максимум регистров)
+ * её счётчика и счётчиков её соседей на шаге t, поэтому после L шагов он описывает
+ * множество городов, достижимых из v не более чем за L пересадок. Шаги
+ * выполняются параллельно по вершинам. Стандартная ошибка оценки ≈ 1.04 / sqrt(2^precision).
+ */
+class NeighborhoodSketches {
+public:
+    /**
+     * @brief Строит счётчики
+     * @param graph Граф в формате CSR
+     * @param L Максимальное число пересадок
+     * @param precision Число бит индекса регистра (4..16), регистров 2^precision на вершину
+     * @param threads Число потоков (0 — по числу ядер)
+     */
+    NeighborhoodSketches(const CsrGraph& graph, int L, int precision = 10, unsigned threads = 0);
+
+    /**
+     * @brief Число выполненных шагов (меньше L, если счётчики перестали меняться)
+     */
+    int levels() const;
+
+    /**
+     * @brief Оценка числа городов, достижимых из v
+     */
+    double reachableCount(int v) const;
+
+    /**
+     * @brief Оценки числа достижимых городов для всех вершин
+     */
+    std::vector<double> reachableCounts() const;
+
+    /**
+     * @brief Оценка размера объединения окрестностей a и b
+     */
+    double unionCount(int a, int b) const;
+
+    /**
+     * @brief Оценка числа общих городов окрестностей a и b по формуле включений-исключений
+     */
+    double commonCount(int a, int b) const;
+
+    /**
+     * @brief Память, занятая регистрами, в байтах
+     */
+    std::size_t bytes() const;
+
+private:
+    const std::uint8_t* sketch(int v) const;
+    double estimate(const std::uint8_t* registers) const;
+
+    int n_ = 0;
+    int precision_ = 0;
+    std::size_t registers_per_vertex_ = 0;
+    int levels_ = 0;
+    std::vector<std::uint8_t> registers_;
+};
+
+#endif // NEIGHBORHOODSKETCH_H
@@ -0,0 +1,109 @@
+/**
+ * @file ReachabilityCache.cpp
+ * @brief Реализация кэша множеств достижимости
+ */
+
+#include "ReachabilityCache.h"
+#include <algorithm>
+
+using namespace std;
+
+int ReachabilityCache::Entry::depth() const {
+    return static_cast<int>(level_end.size()) - 1;
+}
+
+size_t ReachabilityCache::Entry::bytes() const {
+    return sizeof(Entry)
+        + order.capacity() * sizeof(int)
+        + level_end.capacity() * sizeof(size_t)
+        + visited.capacity() * sizeof(uint64_t);
+}
+
+ReachabilityCache::ReachabilityCache(const CsrGraph& graph, size_t max_bytes)
+    : graph_(graph), max_bytes_(max_bytes) {}
+
+set<int> ReachabilityCache::operator()(int start, int L) {
+    auto it = index_.find(start);
+    if (it == index_.end()) {
+        ++stats_.misses;
+        lru_.emplace_front();
+        Entry& entry = lru_.front();
+        entry.start = start;
+        entry.visited.assign((static_cast<size_t>(graph_.vertexCount()) + 63) / 64, 0);
+        entry.visited[start >> 6] |= uint64_t{1} << (start & 63);
+        entry.order.push_back(start);
+        entry.level_end.push_back(1);
+        index_[start] = lru_.begin();
+        stats_.bytes += entry.bytes();
+    } else {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        const Entry& entry = lru_.front();
+        if (entry.depth() >= L || entry.complete) {
+            ++stats_.hits;
+        } else {
+            ++stats_.extensions;
+        }
+    }
+
+    Entry& entry = lru_.front();
+    if (entry.depth() < L && !entry.complete) {
+        size_t before = entry.bytes();
+        extend(entry, L);
+        stats_.bytes = stats_.bytes - before + entry.bytes();
+    }
+
+    int level = max(0, min(L, entry.depth()));
+    set<int> result(entry.order.begin(), entry.order.begin() + entry.level_end[level]);
+
+    evict();
+    return result;
+}
+
+CacheStats ReachabilityCache::stats() const {
+    CacheStats result = stats_;
+    result.entries = lru_.size();
+    return result;
+}
+
+void ReachabilityCache::clear() {
+    lru_.clear();
+    index_.clear();
+    stats_.bytes = 0;
+}
+
+void ReachabilityCache::extend(Entry& entry, int L) const {
+    while (entry.depth() < L) {
+        size_t begin = entry.depth() == 0 ? 0 : entry.level_end[entry.depth() - 1];
+        size_t end = entry.level_end.back();
+
+        for (size_t i = begin; i < end; ++i) {
+            int city = entry.order[i];
+            for (size_t e = graph_.offsets[city]; e < graph_.offsets[city + 1]; ++e) {
+                int neighbor = graph_.neighbors[e];
+                uint64_t mask = uint64_t{1} << (neighbor & 63);
+                if (!(entry.visited[neighbor >> 6] & mask)) {
+                    entry.visited[neighbor >> 6] |= mask;
+                    entry.order.push_back(neighbor);
+                }
+            }
+        }
+
+        if (entry.order.size() == end) {
+            // Компонента исчерпана: битовая карта больше не понадобится
+            entry.complete = true;
+            vector<uint64_t>().swap(entry.visited);
+            break;
+        }
+        entry.level_end.push_back(entry.order.size());
+    }
+}
+
+void ReachabilityCache::evict() {
+    while (stats_.bytes > max_bytes_ && lru_.size() > 1) {
+        const Entry& victim = lru_.back();
+        stats_.bytes -= victim.bytes();
+        index_.erase(victim.start);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+}
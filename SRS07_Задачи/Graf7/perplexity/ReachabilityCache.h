@@ -0,0 +1,87 @@
+/**
+ * @file ReachabilityCache.h
+ * @brief Кэш результатов поиска достижимых городов с доращиванием по L
+ */
+
+#ifndef REACHABILITYCACHE_H
+#define REACHABILITYCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Счётчики кэша для подбора его размера
+ */
+struct CacheStats {
+    std::uint64_t hits = 0;        ///< Ответ получен из сохранённых уровней
+    std::uint64_t extensions = 0;  ///< Обход продолжен с сохранённого фронта
+    std::uint64_t misses = 0;      ///< Обход выполнен с нуля
+    std::uint64_t evictions = 0;   ///< Вытеснено записей
+    std::size_t entries = 0;       ///< Записей в кэше
+    std::size_t bytes = 0;         ///< Память, занятая записями
+};
+
+/**
+ * @brief LRU-кэш множеств достижимости, ключ — начальный город
+ *
+ * Для каждого города хранится порядок обхода в ширину, смещения концов уровней
+ * и битовая карта посещённых на глубочайшем вычисленном уровне. Запрос с меньшим L
+ * отвечается префиксом порядка обхода, с большим — продолжением обхода
+ * с последнего фронта. Класс не потокобезопасен.
+ */
+class ReachabilityCache {
+public:
+    /**
+     * @brief Конструктор
+     * @param graph Граф в формате CSR (должен жить дольше кэша)
+     * @param max_bytes Ограничение на суммарный размер записей
+     */
+    ReachabilityCache(const CsrGraph& graph, std::size_t max_bytes);
+
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     * @param start Начальный город (0-based индекс)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы)
+     */
+    std::set<int> operator()(int start, int L);
+
+    /**
+     * @brief Возвращает счётчики кэша
+     */
+    CacheStats stats() const;
+
+    /**
+     * @brief Очищает кэш (счётчики попаданий сохраняются)
+     */
+    void clear();
+
+private:
+    struct Entry {
+        int start = 0;
+        std::vector<int> order;               ///< Вершины в порядке обхода
+        std::vector<std::size_t> level_end;   ///< level_end[d] — число вершин на уровнях 0..d
+        std::vector<std::uint64_t> visited;   ///< Посещённые вершины
+        bool complete = false;                ///< Фронт исчерпан, дальше шар не растёт
+
+        int depth() const;
+        std::size_t bytes() const;
+    };
+
+    void extend(Entry& entry, int L) const;
+    void evict();
+
+    const CsrGraph& graph_;
+    std::size_t max_bytes_;
+    std::list<Entry> lru_;
+    std::unordered_map<int, std::list<Entry>::iterator> index_;
+    CacheStats stats_;
+};
+
+#endif // REACHABILITYCACHE_H
@@ -0,0 +1,206 @@
+/**
+ * @file TwinGraph.cpp
+ * @brief Реализация сжатия по вершинам-близнецам
+ */
+
+#include "TwinGraph.h"
+#include <algorithm>
+
+#include "BitUtils.h"
+#include "CompressedGraph.h"
+
+using namespace std;
+
+namespace {
+
+uint64_t hashList(const int* begin, const int* end, uint64_t seed) {
+    uint64_t hash = mixHash(seed + static_cast<uint64_t>(end - begin));
+    for (const int* p = begin; p != end; ++p) {
+        hash = mixHash(hash ^ static_cast<uint32_t>(*p));
+    }
+    return hash;
+}
+
+/**
+ * @brief Строит обратный граф (входящие дуги), списки остаются отсортированными
+ */
+CsrGraph reverseGraph(const CsrGraph& graph) {
+    int n = graph.vertexCount();
+    CsrGraph reversed;
+    reversed.offsets.assign(n + 1, 0);
+    for (int u : graph.neighbors) ++reversed.offsets[u + 1];
+    for (int v = 0; v < n; ++v) reversed.offsets[v + 1] += reversed.offsets[v];
+
+    reversed.neighbors.resize(graph.neighbors.size());
+    vector<size_t> fill_pos(reversed.offsets.begin(), reversed.offsets.end() - 1);
+    for (int v = 0; v < n; ++v) {
+        for (size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+            reversed.neighbors[fill_pos[graph.neighbors[e]]++] = v;
+        }
+    }
+    return reversed;
+}
+
+const int* listBegin(const CsrGraph& graph, int v) {
+    return graph.neighbors.data() + graph.offsets[v];
+}
+
+const int* listEnd(const CsrGraph& graph, int v) {
+    return graph.neighbors.data() + graph.offsets[v + 1];
+}
+
+bool sameList(const CsrGraph& graph, int a, int b) {
+    return equal(listBegin(graph, a), listEnd(graph, a), listBegin(graph, b), listEnd(graph, b));
+}
+
+} // namespace
+
+TwinQuotientGraph::TwinQuotientGraph(const CsrGraph& graph) : n_(graph.vertexCount()) {
+    CsrGraph reversed = reverseGraph(graph);
+
+    vector<uint64_t> hashes(n_);
+    for (int v = 0; v < n_; ++v) {
+        hashes[v] = hashList(listBegin(graph, v), listEnd(graph, v), 1) ^
+                    (hashList(listBegin(reversed, v), listEnd(reversed, v), 2) * 3);
+    }
+
+    // Вершины с равным хешем оказываются рядом; внутри серии сравниваем списки точно
+    vector<int> order(n_);
+    for (int v = 0; v < n_; ++v) order[v] = v;
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : a < b;
+    });
+
+    vector<int> leader(n_, -1);
+    vector<int> run_leaders;
+    for (size_t i = 0; i < order.size();) {
+        size_t j = i;
+        while (j < order.size() && hashes[order[j]] == hashes[order[i]]) ++j;
+
+        run_leaders.clear();
+        for (size_t k = i; k < j; ++k) {
+            int v = order[k];
+            for (int r : run_leaders) {
+                if (sameList(graph, r, v) && sameList(reversed, r, v)) {
+                    leader[v] = r;
+                    break;
+                }
+            }
+            if (leader[v] < 0) {
+                leader[v] = v;
+                run_leaders.push_back(v);
+            }
+        }
+        i = j;
+    }
+
+    // Классы нумеруются в порядке наименьших вершин, представитель — наименьшая вершина
+    class_of_.assign(n_, -1);
+    vector<int> representative;
+    for (int v = 0; v < n_; ++v) {
+        if (leader[v] == v) {
+            class_of_[v] = static_cast<int>(representative.size());
+            representative.push_back(v);
+        } else {
+            class_of_[v] = class_of_[leader[v]];
+        }
+    }
+
+    int count = static_cast<int>(representative.size());
+    member_offsets_.assign(count + 1, 0);
+    for (int v = 0; v < n_; ++v) ++member_offsets_[class_of_[v] + 1];
+    for (int c = 0; c < count; ++c) member_offsets_[c + 1] += member_offsets_[c];
+    members_.resize(n_);
+    vector<int> fill_pos(member_offsets_.begin(), member_offsets_.end() - 1);
+    for (int v = 0; v < n_; ++v) members_[fill_pos[class_of_[v]]++] = v;
+
+    // Все вершины класса имеют одинаковые строки, поэтому дуги класса — дуги представителя.
+    // Из-за совпадения столбцов соседи представителя покрывают целые классы.
+    quotient_.offsets.assign(count + 1, 0);
+    for (int c = 0; c < count; ++c) {
+        int r = representative[c];
+        size_t list_start = quotient_.neighbors.size();
+        for (size_t e = graph.offsets[r]; e < graph.offsets[r + 1]; ++e) {
+            quotient_.neighbors.push_back(class_of_[graph.neighbors[e]]);
+        }
+        auto first = quotient_.neighbors.begin() + list_start;
+        sort(first, quotient_.neighbors.end());
+        quotient_.neighbors.erase(unique(first, quotient_.neighbors.end()), quotient_.neighbors.end());
+        quotient_.offsets[c + 1] = quotient_.neighbors.size();
+    }
+    quotient_.neighbors.shrink_to_fit();
+}
+
+int TwinQuotientGraph::vertexCount() const {
+    return n_;
+}
+
+int TwinQuotientGraph::classCount() const {
+    return quotient_.vertexCount();
+}
+
+const CsrGraph& TwinQuotientGraph::quotient() const {
+    return quotient_;
+}
+
+int TwinQuotientGraph::classOf(int v) const {
+    return class_of_[v];
+}
+
+const int* TwinQuotientGraph::classBegin(int c) const {
+    return members_.data() + member_offsets_[c];
+}
+
+const int* TwinQuotientGraph::classEnd(int c) const {
+    return members_.data() + member_offsets_[c + 1];
+}
+
+size_t TwinQuotientGraph::bytes() const {
+    return csrBytes(quotient_) + (class_of_.capacity() + member_offsets_.capacity() + members_.capacity()) * sizeof(int);
+}
+
+set<int> TwinReachableCitiesFinder::operator()(const TwinQuotientGraph& graph, int start, int L) const {
+    return bitmapToSet(reachableBitmap(graph, start, L));
+}
+
+vector<uint64_t> TwinReachableCitiesFinder::reachableBitmap(const TwinQuotientGraph& graph, int start, int L) const {
+    const CsrGraph& quotient = graph.quotient();
+    int start_class = graph.classOf(start);
+
+    vector<uint64_t> reached((static_cast<size_t>(graph.classCount()) + 63) / 64, 0);
+    reached[start_class >> 6] |= uint64_t{1} << (start_class & 63);
+
+    // Близнецы начального города достижимы, только если обход вернулся в его класс
+    bool returned = false;
+    vector<int> frontier{start_class};
+    vector<int> next;
+
+    for (int level = 0; level < L && !frontier.empty(); ++level) {
+        next.clear();
+        for (int c : frontier) {
+            for (size_t e = quotient.offsets[c]; e < quotient.offsets[c + 1]; ++e) {
+                int neighbor = quotient.neighbors[e];
+                if (neighbor == start_class) returned = true;
+                uint64_t mask = uint64_t{1} << (neighbor & 63);
+                if (!(reached[neighbor >> 6] & mask)) {
+                    reached[neighbor >> 6] |= mask;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    vector<uint64_t> visited((static_cast<size_t>(graph.vertexCount()) + 63) / 64, 0);
+    for (size_t word = 0; word < reached.size(); ++word) {
+        for (uint64_t bits = reached[word]; bits; bits &= bits - 1) {
+            int c = static_cast<int>(word * 64) + countTrailingZeros(bits);
+            if (c == start_class && !returned) continue;
+            for (const int* v = graph.classBegin(c); v != graph.classEnd(c); ++v) {
+                visited[*v >> 6] |= uint64_t{1} << (*v & 63);
+            }
+        }
+    }
+    visited[start >> 6] |= uint64_t{1} << (start & 63);
+    return visited;
+}
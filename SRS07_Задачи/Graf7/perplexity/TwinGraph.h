@@ -0,0 +1,95 @@
+/**
+ * @file TwinGraph.h
+ * @brief Сжатие графа по вершинам-близнецам и обход по фактор-графу
+ */
+
+#ifndef TWINGRAPH_H
+#define TWINGRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Граф, в котором классы вершин-близнецов заменены одним представителем
+ *
+ * Близнецы — вершины с одинаковыми строкой (исходящие дуги) и столбцом (входящие дуги)
+ * матрицы смежности, например пригороды, связанные только с одним узлом. Строки и
+ * столбцы сравниваются по хешу, совпадения проверяются точно. Расстояние от любого
+ * другого города до всех вершин класса одинаково, поэтому обход по фактор-графу с
+ * последующим раскрытием классов даёт в точности тот же ответ, что и обход исходного графа.
+ */
+class TwinQuotientGraph {
+public:
+    /**
+     * @brief Находит классы близнецов и строит фактор-граф
+     * @param graph Граф в формате CSR (списки соседей отсортированы)
+     */
+    explicit TwinQuotientGraph(const CsrGraph& graph);
+
+    /**
+     * @brief Число вершин исходного графа
+     */
+    int vertexCount() const;
+
+    /**
+     * @brief Число классов (вершин фактор-графа)
+     */
+    int classCount() const;
+
+    /**
+     * @brief Фактор-граф: вершины — классы, дуга есть, если есть дуга между их вершинами
+     */
+    const CsrGraph& quotient() const;
+
+    /**
+     * @brief Класс вершины исходного графа
+     */
+    int classOf(int v) const;
+
+    /**
+     * @brief Вершины класса по возрастанию номеров: [begin, end)
+     */
+    const int* classBegin(int c) const;
+    const int* classEnd(int c) const;
+
+    /**
+     * @brief Память, занятая фактор-графом и таблицами классов, в байтах
+     */
+    std::size_t bytes() const;
+
+private:
+    int n_ = 0;
+    CsrGraph quotient_;
+    std::vector<int> class_of_;
+    std::vector<int> member_offsets_;
+    std::vector<int> members_;
+};
+
+/**
+ * @brief Функциональный объект для поиска достижимых городов по фактор-графу близнецов
+ *
+ * Обход идёт по классам; другие вершины класса начального города достижимы только
+ * через возврат в этот класс, что отслеживается отдельно.
+ */
+class TwinReachableCitiesFinder {
+public:
+    /**
+     * @brief Находит города, достижимые из заданного с не более чем L пересадками
+     * @param graph Фактор-граф близнецов
+     * @param start Начальный город (0-based индекс исходного графа)
+     * @param L Максимальное число пересадок
+     * @return Множество достижимых городов (0-based индексы исходного графа)
+     */
+    std::set<int> operator()(const TwinQuotientGraph& graph, int start, int L) const;
+
+    /**
+     * @brief То же, что operator(), но возвращает битовую карту посещённых вершин исходного графа
+     */
+    std::vector<std::uint64_t> reachableBitmap(const TwinQuotientGraph& graph, int start, int L) const;
+};
+
+#endif // TWINGRAPH_H
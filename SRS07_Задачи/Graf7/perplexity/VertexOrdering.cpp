@@ -0,0 +1,152 @@
+/**
+ * @file VertexOrdering.cpp
+ * @brief Реализация перенумерации вершин графа
+ */
+
+#include "VertexOrdering.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace {
+
+int degree(const CsrGraph& graph, int v) {
+    return static_cast<int>(graph.offsets[v + 1] - graph.offsets[v]);
+}
+
+/**
+ * @brief Обход в ширину всех компонент; при by_degree соседи посещаются по возрастанию степени,
+ *        а каждая компонента начинается с вершины минимальной степени
+ */
+vector<int> bfsOrder(const CsrGraph& graph, bool by_degree) {
+    int n = graph.vertexCount();
+    vector<int> seeds(n);
+    iota(seeds.begin(), seeds.end(), 0);
+    if (by_degree) {
+        stable_sort(seeds.begin(), seeds.end(), [&](int a, int b) {
+            return degree(graph, a) < degree(graph, b);
+        });
+    }
+
+    vector<char> visited(n, 0);
+    vector<int> order;
+    order.reserve(n);
+    vector<int> children;
+
+    for (int seed : seeds) {
+        if (visited[seed]) continue;
+        visited[seed] = 1;
+        size_t head = order.size();
+        order.push_back(seed);
+
+        while (head < order.size()) {
+            int city = order[head++];
+            children.clear();
+            for (size_t e = graph.offsets[city]; e < graph.offsets[city + 1]; ++e) {
+                int neighbor = graph.neighbors[e];
+                if (!visited[neighbor]) {
+                    visited[neighbor] = 1;
+                    children.push_back(neighbor);
+                }
+            }
+            if (by_degree) {
+                stable_sort(children.begin(), children.end(), [&](int a, int b) {
+                    return degree(graph, a) < degree(graph, b);
+                });
+            }
+            order.insert(order.end(), children.begin(), children.end());
+        }
+    }
+
+    return order;
+}
+
+} // namespace
+
+bool parseVertexOrder(const string& name, VertexOrder& order) {
+    if (name == "none") order = VertexOrder::Original;
+    else if (name == "bfs") order = VertexOrder::Bfs;
+    else if (name == "rcm") order = VertexOrder::ReverseCuthillMcKee;
+    else if (name == "degree") order = VertexOrder::DegreeSorted;
+    else return false;
+    return true;
+}
+
+int VertexPermutation::toInternal(int city) const {
+    return new_id[city - 1];
+}
+
+int VertexPermutation::toExternal(int vertex) const {
+    return old_id[vertex] + 1;
+}
+
+vector<int> VertexPermutation::toExternal(const vector<int>& vertices) const {
+    vector<int> cities;
+    cities.reserve(vertices.size());
+    for (int v : vertices) {
+        cities.push_back(toExternal(v));
+    }
+    sort(cities.begin(), cities.end());
+    return cities;
+}
+
+VertexPermutation computeOrdering(const CsrGraph& graph, VertexOrder order) {
+    int n = graph.vertexCount();
+    VertexPermutation permutation;
+
+    switch (order) {
+        case VertexOrder::Original:
+            permutation.old_id.resize(n);
+            iota(permutation.old_id.begin(), permutation.old_id.end(), 0);
+            break;
+        case VertexOrder::Bfs:
+            permutation.old_id = bfsOrder(graph, false);
+            break;
+        case VertexOrder::ReverseCuthillMcKee:
+            permutation.old_id = bfsOrder(graph, true);
+            reverse(permutation.old_id.begin(), permutation.old_id.end());
+            break;
+        case VertexOrder::DegreeSorted:
+            permutation.old_id.resize(n);
+            iota(permutation.old_id.begin(), permutation.old_id.end(), 0);
+            stable_sort(permutation.old_id.begin(), permutation.old_id.end(), [&](int a, int b) {
+                return degree(graph, a) > degree(graph, b);
+            });
+            break;
+    }
+
+    permutation.new_id.resize(n);
+    for (int v = 0; v < n; ++v) {
+        permutation.new_id[permutation.old_id[v]] = v;
+    }
+    return permutation;
+}
+
+CsrGraph permuteGraph(const CsrGraph& graph, const VertexPermutation& permutation) {
+    int n = graph.vertexCount();
+    CsrGraph result;
+    result.offsets.reserve(static_cast<size_t>(n) + 1);
+    result.offsets.push_back(0);
+    result.neighbors.reserve(graph.edgeCount());
+
+    for (int v = 0; v < n; ++v) {
+        int old = permutation.old_id[v];
+        size_t begin = result.neighbors.size();
+        for (size_t e = graph.offsets[old]; e < graph.offsets[old + 1]; ++e) {
+            result.neighbors.push_back(permutation.new_id[graph.neighbors[e]]);
+        }
+        sort(result.neighbors.begin() + begin, result.neighbors.end());
+        result.offsets.push_back(result.neighbors.size());
+    }
+
+    return result;
+}
+
+VertexPermutation reorderGraph(CsrGraph& graph, VertexOrder order) {
+    VertexPermutation permutation = computeOrdering(graph, order);
+    if (order != VertexOrder::Original) {
+        graph = permuteGraph(graph, permutation);
+    }
+    return permutation;
+}
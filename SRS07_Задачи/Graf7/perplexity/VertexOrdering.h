@@ -0,0 +1,81 @@
+/**
+ * @file VertexOrdering.h
+ * @brief Перенумерация вершин графа при загрузке для лучшей локальности обхода
+ */
+
+#ifndef VERTEXORDERING_H
+#define VERTEXORDERING_H
+
+#include <string>
+#include <vector>
+
+#include "CsrGraph.h"
+
+/**
+ * @brief Способ перенумерации вершин
+ */
+enum class VertexOrder {
+    Original,             ///< Без перенумерации
+    Bfs,                  ///< Порядок обхода в ширину
+    ReverseCuthillMcKee,  ///< Обратный алгоритм Катхилла — Макки
+    DegreeSorted          ///< По убыванию степени
+};
+
+/**
+ * @brief Разбирает название порядка ("none", "bfs", "rcm", "degree")
+ * @param name Название
+ * @param order Результат (выходной параметр)
+ * @return true, если название распознано
+ */
+bool parseVertexOrder(const std::string& name, VertexOrder& order);
+
+/**
+ * @brief Взаимно обратные отображения между исходными и внутренними номерами вершин
+ */
+struct VertexPermutation {
+    std::vector<int> new_id;  ///< new_id[исходный 0-based] — внутренний номер
+    std::vector<int> old_id;  ///< old_id[внутренний] — исходный 0-based номер
+
+    /**
+     * @brief Переводит номер города из входных данных (1-based) во внутренний
+     */
+    int toInternal(int city) const;
+
+    /**
+     * @brief Переводит внутренний номер в номер города для вывода (1-based)
+     */
+    int toExternal(int vertex) const;
+
+    /**
+     * @brief Переводит внутренние номера в 1-based номера городов
+     * @param vertices Внутренние номера
+     * @return Номера городов (1-based), отсортированные по возрастанию
+     */
+    std::vector<int> toExternal(const std::vector<int>& vertices) const;
+};
+
+/**
+ * @brief Вычисляет перенумерацию вершин
+ * @param graph Граф в формате CSR
+ * @param order Способ перенумерации
+ * @return Перестановка вершин
+ */
+VertexPermutation computeOrdering(const CsrGraph& graph, VertexOrder order);
+
+/**
+ * @brief Применяет перестановку к графу
+ * @param graph Граф в исходной нумерации
+ * @param permutation Перестановка
+ * @return Граф во внутренней нумерации (списки соседей отсортированы)
+ */
+CsrGraph permuteGraph(const CsrGraph& graph, const VertexPermutation& permutation);
+
+/**
+ * @brief Перенумеровывает граф на месте и возвращает использованную перестановку
+ * @param graph Граф (заменяется перенумерованным)
+ * @param order Способ перенумерации
+ * @return Перестановка вершин
+ */
+VertexPermutation reorderGraph(CsrGraph& graph, VertexOrder order);
+
+#endif // VERTEXORDERING_H
@@ -3,31 +3,172 @@
  * @brief Точка входа для решения задачи Graf7 (функциональный стиль)
  */
 
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
+#include "CommonCityQuery.h"
+#include "ComponentIndex.h"
+#include "CsrGraph.h"
+#include "ExternalGraph.h"
 #include "GraphUtils.h"
+#include "TwinGraph.h"
+#include "VertexOrdering.h"
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Использование: " << argv[0] << " filename\n";
+    if (argc < 2) {
+        std::cerr << "Использование: " << argv[0]
+                  << " filename [none|bfs|rcm|degree] [--twins] [--exists|--count|--top=K]\n"
+                  << "       " << argv[0] << " filename.csr --external[=MB]\n";
         return EXIT_FAILURE;
     }
 
-    int n = 0;
-    auto graph = readGraph(argv[1], n);
+    // Режим запроса: полный список общих городов, существование, количество или первые K
+    enum class Mode { List, Exists, Count, Top } mode = Mode::List;
+    std::size_t top = 0;
+    std::size_t external_mb = 0;
+    bool twins = false;
+    bool order_given = false;
+    VertexOrder order = VertexOrder::Original;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--exists") {
+            mode = Mode::Exists;
+        } else if (arg == "--count") {
+            mode = Mode::Count;
+        } else if (arg.compare(0, 6, "--top=") == 0) {
+            // K — положительное целое число без посторонних символов
+            const char* digits = arg.c_str() + 6;
+            char* end = nullptr;
+            mode = Mode::Top;
+            top = std::strtoul(digits, &end, 10);
+            if (*digits < '0' || *digits > '9' || *end != '\0' || top == 0) {
+                std::cerr << "K в --top=K должно быть положительным целым числом: " << arg << '\n'
+                          << "Использование: " << argv[0]
+                          << " filename [none|bfs|rcm|degree] [--twins] [--exists|--count|--top=K]\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--twins") {
+            twins = true;
+        } else if (arg == "--external") {
+            external_mb = 64;
+        } else if (arg.compare(0, 11, "--external=") == 0) {
+            // Бюджет — положительное целое число мегабайт без посторонних символов
+            const char* digits = arg.c_str() + 11;
+            char* end = nullptr;
+            external_mb = std::strtoul(digits, &end, 10);
+            if (*digits < '0' || *digits > '9' || *end != '\0' || external_mb == 0) {
+                std::cerr << "Бюджет памяти должен быть положительным числом мегабайт: " << arg << '\n';
+                return EXIT_FAILURE;
+            }
+        } else if (parseVertexOrder(arg, order)) {
+            order_given = true;
+        } else {
+            std::cerr << "Неизвестный параметр: " << arg << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Обход с диска поддерживает только полный список общих городов
+    if (external_mb > 0 && (order_given || twins || mode != Mode::List)) {
+        std::cerr << "--external нельзя сочетать с перенумерацией, --twins, --exists, --count и --top\n"
+                  << "Использование: " << argv[0] << " filename.csr --external[=MB]\n";
+        return EXIT_FAILURE;
+    }
 
     int K1, K2, L;
+
+    // Граф, не помещающийся в память, обходится прямо с диска
+    if (external_mb > 0) {
+        ExternalGraph graph(argv[1]);
+        std::cout << "Введите номера городов K1 и K2 (1-based) и максимальное число пересадок L: ";
+        std::cin >> K1 >> K2 >> L;
+        --K1; --K2;
+
+        ExternalReachableCitiesFinder finder(external_mb << 20);
+        auto commonCities = findCommonCities(finder(graph, K1, L), finder(graph, K2, L));
+        printResult(toOneBased(commonCities));
+        return 0;
+    }
+
+    int n = 0;
+    auto graph = loadGraph(argv[1], n);
+    auto permutation = reorderGraph(graph, order);
+    ComponentIndex components(graph);
+
     std::cout << "Введите номера городов K1 и K2 (1-based) и максимальное число пересадок L: ";
     std::cin >> K1 >> K2 >> L;
 
-    // Переводим в 0-based индексы
-    --K1; --K2;
+    // Переводим во внутренние 0-based индексы
+    K1 = permutation.toInternal(K1);
+    K2 = permutation.toInternal(K2);
+
+    // Часть запросов решается по индексу компонент без обхода
+    auto shortcut = components.shortcut(K1, K2, L);
+    if (shortcut == CommonCityShortcut::Disjoint) {
+        if (mode == Mode::Exists) {
+            std::cout << -1 << '\n';
+        } else if (mode == Mode::Count) {
+            std::cout << 0 << '\n';
+        } else {
+            printResult({});
+        }
+        return 0;
+    }
+
+    switch (mode) {
+        case Mode::Exists:
+            // Шар, совпадающий с компонентой, содержит второй город
+            if (shortcut != CommonCityShortcut::None) {
+                std::cout << 1 << '\n';
+                return 0;
+            }
+            std::cout << (hasCommonCity(graph, K1, K2, L) ? 1 : -1) << '\n';
+            return 0;
+        case Mode::Count:
+            if (shortcut == CommonCityShortcut::BothCover) {
+                std::cout << components.componentSize(components.component(K1)) << '\n';
+                return 0;
+            }
+            std::cout << countCommonCities(graph, K1, K2, L) << '\n';
+            return 0;
+        case Mode::Top:
+            printResult(permutation.toExternal(topCommonCities(graph, K1, K2, L, top, permutation.old_id)));
+            return 0;
+        case Mode::List:
+            break;
+    }
 
-    ReachableCitiesFinder finder;
-    auto reachableFromK1 = finder(graph, K1, L);
-    auto reachableFromK2 = finder(graph, K2, L);
+    // С --twins обход идёт по фактор-графу, где близнецы склеены в одну вершину
+    ParallelReachableCitiesFinder parallelFinder;
+    TwinReachableCitiesFinder twinFinder;
+    std::unique_ptr<TwinQuotientGraph> quotient;
+    if (twins) quotient.reset(new TwinQuotientGraph(graph));
+    auto finder = [&](const CsrGraph& g, int start, int radius) {
+        return quotient ? twinFinder(*quotient, start, radius) : parallelFinder(g, start, radius);
+    };
 
-    auto commonCities = findCommonCities(reachableFromK1, reachableFromK2);
-    auto result = toOneBased(commonCities);
+    std::vector<int> commonCities;
+    switch (shortcut) {
+        case CommonCityShortcut::BothCover:
+            commonCities = components.componentMembers(components.component(K1));
+            break;
+        case CommonCityShortcut::FirstCovers: {
+            auto reachableFromK2 = finder(graph, K2, L);
+            commonCities.assign(reachableFromK2.begin(), reachableFromK2.end());
+            break;
+        }
+        case CommonCityShortcut::SecondCovers: {
+            auto reachableFromK1 = finder(graph, K1, L);
+            commonCities.assign(reachableFromK1.begin(), reachableFromK1.end());
+            break;
+        }
+        default:
+            commonCities = findCommonCities(finder(graph, K1, L), finder(graph, K2, L));
+            break;
+    }
+    auto result = permutation.toExternal(commonCities);
 
     printResult(result);
 